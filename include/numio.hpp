@@ -3,15 +3,24 @@
 
 // ****************************************************************************
 
+#include <array>
 #include <climits>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <xmmintrin.h>
+#endif
+
 // ****************************************************************************
 
 ///
@@ -28,6 +37,9 @@
 ///         - `BIG_ENDIAN` or as integer value `4321`
 /// @param NUMIO_IS_SYSTEM_LITTLE_ENDIAN_V Boolean macro parameter alternative to `NUMIO_SYSTEM_ENDIANNESS_V` for
 ///        defining the target system endianness.
+/// @param NUMIO_CHECK_BOUNDS When defined, (un)packing at an offset of a vector of bytes throws `std::runtime_error`
+///        if the value doesn't fit in the vector. Functions on raw pointers stay unchecked; use the `_checked` batch
+///        functions to validate a whole batch once.
 ///
 namespace NumIO
 {
@@ -102,6 +114,143 @@ namespace NumIO
                 #undef BIG_ENDIAN
             #endif
         }();
+
+        // Amount of elements to look ahead when prefetching scattered positions in batch functions
+        static constexpr std::size_t __PREFETCH_DISTANCE = 16;
+
+        static inline void __prefetch_read(const void* address)
+        {
+            #if defined(__GNUC__) || defined(__clang__)
+                __builtin_prefetch(address, 0, 3);
+            #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+                _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+            #else
+                (void)address;
+            #endif
+        }
+
+        // Byte types of which vectors can be (un)packed from/to
+        template <typename T>
+        static constexpr bool __is_byte_v = std::is_same_v<T, std::uint8_t> || std::is_same_v<T, std::int8_t> ||
+                                            std::is_same_v<T, char> || std::is_same_v<T, std::byte>;
+
+        template <typename T>
+        using __enable_if_byte_t = std::enable_if_t<__is_byte_v<T>>;
+
+        // Checks if `count` values of `n_io_bytes` bytes, `stride` bytes apart, fit in `n_bytes` bytes. Formulated with
+        // a division instead of a multiplication so that it can't overflow
+        static constexpr bool __is_batch_in_bounds(std::size_t n_bytes, std::size_t count, std::size_t stride,
+                                                   std::size_t n_io_bytes)
+        {
+            if (count == 0)
+                return true;
+            if (n_io_bytes > n_bytes)
+                return false;
+            return stride == 0 || count - 1 <= (n_bytes - n_io_bytes) / stride;
+        }
+
+        // Checks if the calling function is evaluated at compile time, to select constexpr implementations of math
+        // functions only there. Without the builtin, the constexpr implementations are used at runtime as well
+        static constexpr bool __is_constant_evaluated()
+        {
+            #if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+                return __builtin_is_constant_evaluated();
+            #elif defined(__has_builtin)
+                #if __has_builtin(__builtin_is_constant_evaluated)
+                    return __builtin_is_constant_evaluated();
+                #else
+                    return true;
+                #endif
+            #elif defined(_MSC_VER) && _MSC_VER >= 1925
+                return __builtin_is_constant_evaluated();
+            #else
+                return true;
+            #endif
+        }
+
+        // constexpr 2^exponent by squaring. Only the powers that are needed are computed, so the intermediate values
+        // don't overflow or underflow beyond the result
+        template <typename FLOAT_T>
+        static constexpr FLOAT_T __pow2(int exponent)
+        {
+            FLOAT_T result = 1;
+            FLOAT_T base = exponent < 0 ? static_cast<FLOAT_T>(0.5) : static_cast<FLOAT_T>(2);
+            unsigned int n = exponent < 0 ? 0u - static_cast<unsigned int>(exponent) : static_cast<unsigned int>(exponent);
+            while (n) {
+                if (n & 1)
+                    result *= base;
+                n >>= 1;
+                if (n)
+                    base *= base;
+            }
+            return result;
+        }
+
+        // constexpr std::frexp() for positive finite nonzero values
+        template <typename FLOAT_T>
+        static constexpr FLOAT_T __frexp(FLOAT_T value, int& exponent)
+        {
+            if (!__is_constant_evaluated())
+                return std::frexp(value, &exponent);
+
+            int largest_step = 1;
+            while (largest_step * 2 < std::numeric_limits<FLOAT_T>::max_exponent)
+                largest_step *= 2;
+
+            // Scale into [0.5, 2) in power-of-two steps, largest first
+            exponent = 0;
+            for (int step=largest_step; step>0; step/=2) {
+                const FLOAT_T scale = __pow2<FLOAT_T>(step);
+                while (value >= scale) {
+                    value /= scale;
+                    exponent += step;
+                }
+                while (value * scale < 1) {
+                    value *= scale;
+                    exponent -= step;
+                }
+            }
+            if (value >= 1) {
+                value *= static_cast<FLOAT_T>(0.5);
+                exponent += 1;
+            }
+            return value;
+        }
+
+        // constexpr std::signbit(). Negative zero can only be told apart at compile time with GCC builtins
+        template <typename FLOAT_T>
+        static constexpr bool __is_negative(FLOAT_T value)
+        {
+            #if defined(__GNUC__) && !defined(__clang__)
+                return __builtin_signbit(value);
+            #else
+                if (__is_constant_evaluated())
+                    return value < 0;
+                return std::signbit(value);
+            #endif
+        }
+
+        // Integer hash (SplitMix64 finalizer) used as a counter-based random number generator for stochastic rounding
+        static constexpr std::uint64_t __mix64(std::uint64_t x)
+        {
+            x ^= x >> 30;
+            x *= 0xBF58476D1CE4E5B9ull;
+            x ^= x >> 27;
+            x *= 0x94D049BB133111EBull;
+            x ^= x >> 31;
+            return x;
+        }
+
+        static inline void __prefetch_write(const void* address)
+        {
+            #if defined(__GNUC__) || defined(__clang__)
+                __builtin_prefetch(address, 1, 3);
+            #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+                _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+            #else
+                (void)address;
+            #endif
+        }
     }
 
     ///
@@ -115,6 +264,107 @@ namespace NumIO
         NETWORK = BIG,
     };
 
+    ///
+    /// @brief Policies for packing floats that are too large for the designated format.
+    ///
+    enum class OverflowPolicy
+    {
+        /// Throw `std::runtime_error`.
+        THROW,
+        /// Pack the largest finite value of the format, with the sign of the input.
+        SATURATE,
+        /// Pack infinity, with the sign of the input (as IEEE 754 rounding does).
+        TO_INFINITY,
+    };
+
+    ///
+    /// @brief Rounding modes for packing floats into formats with less precision.
+    ///
+    enum class RoundingMode
+    {
+        /// Round to nearest, ties to even (IEEE 754 default).
+        NEAREST_EVEN,
+        /// Round toward zero, i.e. truncate.
+        TOWARD_ZERO,
+        /// Round to nearest, ties away from zero.
+        HALF_AWAY,
+        /// Round up with a probability equal to the distance to the lower value, using caller-provided random bits.
+        STOCHASTIC,
+    };
+
+    ///
+    /// @brief Handling of denormalized (subnormal) values by `FloatIO`.
+    ///
+    enum class DenormalMode
+    {
+        /// Keep denormalized values in both directions.
+        PRESERVE,
+        /// Flush-to-zero: pack values below the smallest normalized value of the format as signed zero.
+        FTZ,
+        /// Denormals-are-zero: unpack denormalized values as signed zero.
+        DAZ,
+        /// Both `FTZ` and `DAZ`.
+        FTZ_DAZ,
+    };
+
+    ///
+    /// @brief Outcome of reading from a stream without exceptions.
+    ///
+    enum class ReadStatus
+    {
+        /// The value was read.
+        OK,
+        /// The stream ended before the value; no bytes were consumed.
+        END_OF_STREAM,
+        /// The stream ended within the value; the available bytes were consumed.
+        TRUNCATED,
+        /// The stream failed for another reason than its end.
+        FAILED,
+    };
+
+    ///
+    /// @brief Value read from a stream, along with the status of the read.
+    ///
+    /// @tparam T Value type.
+    ///
+    template <typename T>
+    struct ReadResult
+    {
+        /// Outcome of the read.
+        ReadStatus status;
+        /// Value read, or zero if `status` isn't `ReadStatus::OK`.
+        T value;
+
+        ///
+        /// @brief Checks if the value was read.
+        ///
+        explicit operator bool() const
+        { return status == ReadStatus::OK; }
+    };
+
+    namespace {
+        // Size of the stack buffer used for reading and writing batches from/to streams
+        static constexpr std::size_t __READ_BLOCK_SIZE = 4096;
+
+        // Reads up to `n` bytes and returns the amount read, also if the stream has exceptions enabled
+        static inline std::size_t __read_bytes(std::istream& s, std::uint8_t* bytes, std::size_t n)
+        {
+            try {
+                s.read(reinterpret_cast<char*>(bytes), static_cast<std::streamsize>(n));
+            }
+            catch (const std::ios_base::failure&) {}
+            return static_cast<std::size_t>(s.gcount());
+        }
+
+        // Status of a read that returned fewer bytes than requested
+        static inline ReadStatus __short_read_status(const std::istream& s, std::size_t n_read)
+        {
+            if (s.bad() || !s.eof())
+                return ReadStatus::FAILED;
+            return n_read ? ReadStatus::TRUNCATED : ReadStatus::END_OF_STREAM;
+        }
+    }
+
     #ifndef NUMIO_DEFAULT_ENDIAN_V
         #define NUMIO_DEFAULT_ENDIAN_V Endian::LITTLE
     #endif
@@ -164,12 +414,12 @@ namespace NumIO
                 return 0;
         }();
 
-        static constexpr INT_T _VALUE_MASK = []{
+        static constexpr INT_T _VALUE_MASK = []() -> INT_T {
             if (_N_CONTAINER_BITS == N_BITS) {
                 return ~static_cast<INT_T>(0);
             }
             INT_T mask = 0;
-            for (int i=0; i<N_BITS; i++) {
+            for (unsigned int i=0; i<N_BITS; i++) {
                 mask |= (static_cast<INT_T>(1) << i);
             }
             return mask;
@@ -182,6 +432,94 @@ namespace NumIO
                 : 0;
         }
 
+        // Position in the buffer of the I-th least significant byte
+        template<Endian ENDIANNESS_V, std::size_t I>
+        static constexpr std::size_t _BYTE_INDEX = _get_endianness_offset(ENDIANNESS_V)
+            ? _get_endianness_offset(ENDIANNESS_V) - I
+            : I;
+
+        // The per-byte code is generated from index sequences instead of loops, so that it is straight-line code
+        // without relying on the optimizer to unroll, which it doesn't do in debug builds. Shifting is done unsigned,
+        // as shifting a byte into the sign bit of a signed type is undefined
+        template<Endian ENDIANNESS_V, std::size_t... I>
+        static constexpr INT_T _unpack_bytes(const std::uint8_t* bytes, std::index_sequence<I...>)
+        {
+            using UINT_T = std::make_unsigned_t<INT_T>;
+            return static_cast<INT_T>(static_cast<UINT_T>(
+                (static_cast<UINT_T>(0) | ... | (static_cast<UINT_T>(bytes[_BYTE_INDEX<ENDIANNESS_V, I>]) << (I * 8)))));
+        }
+
+        template<Endian ENDIANNESS_V, std::size_t... I>
+        static constexpr void _pack_bytes(INT_T value, std::uint8_t* bytes, std::index_sequence<I...>)
+        {
+            const auto bits = static_cast<std::make_unsigned_t<INT_T>>(value);
+            ((bytes[_BYTE_INDEX<ENDIANNESS_V, I>] = static_cast<std::uint8_t>((bits >> (I * 8)) & 0xFF)), ...);
+        }
+
+        template<std::size_t... I>
+        static constexpr void _clear_bytes(std::uint8_t* bytes, std::index_sequence<I...>)
+        { ((bytes[I] = 0), ...); }
+
+        #if defined(__AVX2__)
+        // Gathers 8 values at a time into 32-bit containers by loading a 4-byte window per element. Returns the
+        // amount of values processed; blocks whose window would read past the end fall back to scalar unpacking
+        template<Endian ENDIANNESS_V>
+        static std::size_t _gather_unpack_avx2(const std::uint8_t* bytes, std::size_t n_bytes,
+                                               const std::uint32_t* indices, std::size_t count, INT_T* out)
+        {
+            if constexpr (sizeof(INT_T) != 4 || N_IO_BYTES > 4)
+                return 0;
+            else
+            {
+                if (n_bytes < 4 || n_bytes > static_cast<std::size_t>(INT32_MAX))
+                    return 0;
+
+                constexpr auto endianness_offset = _get_endianness_offset(ENDIANNESS_V);
+
+                // Shuffle moving the data bytes of every lane into little endian order, zeroing the rest
+                alignas(32) std::uint8_t shuffle[32];
+                for (int lane=0; lane<8; lane++) {
+                    for (int i=0; i<4; i++) {
+                        shuffle[lane*4+i] = i < _N_DATA_BYTES
+                            ? static_cast<std::uint8_t>((lane % 4) * 4 + (endianness_offset ? endianness_offset-i : i))
+                            : 0x80;
+                    }
+                }
+                const __m256i v_shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(shuffle));
+                const __m256i v_stride = _mm256_set1_epi32(N_IO_BYTES);
+                // Highest element index of which the 4-byte window is still in range
+                const __m256i v_limit = _mm256_set1_epi32(static_cast<int>((n_bytes - 4) / N_IO_BYTES));
+
+                std::size_t i = 0;
+                for (; i+8<=count; i+=8)
+                {
+                    __m256i v_index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+                    __m256i in_range = _mm256_cmpeq_epi32(_mm256_max_epu32(v_index, v_limit), v_limit);
+                    if (_mm256_movemask_epi8(in_range) != -1) {
+                        for (std::size_t j=i; j<i+8; j++)
+                            out[j] = unpack<ENDIANNESS_V>(bytes + static_cast<std::size_t>(indices[j]) * N_IO_BYTES);
+                        continue;
+                    }
+
+                    __m256i v_offset = _mm256_mullo_epi32(v_index, v_stride);
+                    __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(bytes), v_offset, 1);
+                    v = _mm256_shuffle_epi8(v, v_shuffle);
+
+                    if constexpr (N_BITS != _N_CONTAINER_BITS)
+                    {
+                        if constexpr (std::is_signed_v<INT_T>)
+                            v = _mm256_srai_epi32(_mm256_slli_epi32(v, 32 - N_BITS), 32 - N_BITS);
+                        else
+                            v = _mm256_and_si256(v, _mm256_set1_epi32(static_cast<int>(_VALUE_MASK)));
+                    }
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+                }
+                return i;
+            }
+        }
+        #endif
+
 
         // :: PUBLIC ATTRIBUTES :: //
         public:
@@ -191,38 +529,34 @@ namespace NumIO
         ///
         static constexpr int N_IO_BYTES = _N_DATA_BYTES + _N_ALIGN_BYTES;
 
+        ///
+        /// @brief The amount of bits of the packed integer value.
+        ///
+        static constexpr unsigned int N_VALUE_BITS = N_BITS;
+
+        ///
+        /// @brief Integer container type.
+        ///
+        using value_type = INT_T;
+
 
         // :: UNPACKING FUNCTIONS :: //
         public:
 
         ///
-        /// @brief Unpacks an integer from a vector of bytes.
+        /// @brief Unpacks an integer from a buffer of bytes.
         ///
         /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
-        /// @param bytes Vector of bytes to read from.
-        /// @param offset Offset in bytes to extract from of the vector.
+        /// @param bytes Pointer to the first byte of the packed data. At least `N_IO_BYTES` bytes must be readable.
         /// @return Integer value.
         ///
         template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
-        static INT_T unpack(std::vector<std::uint8_t>& bytes, const unsigned int offset=0)
+        static constexpr INT_T unpack(const std::uint8_t* bytes)
         {
-            INT_T result = 0;
-
-            static constexpr auto endianness_offset = _get_endianness_offset(ENDIANNESS_V);
+            constexpr auto endianness_offset = _get_endianness_offset(ENDIANNESS_V);
 
             // Copy the input bytes into the result
-            if constexpr (endianness_offset) // Reversed order
-            {
-                for (short i=0; i<_N_DATA_BYTES; i++) {
-                    result |= static_cast<INT_T>(bytes[endianness_offset-i+offset]) << (i * 8);
-                }
-            }
-            else
-            {
-                for (short i=0; i<_N_DATA_BYTES; i++) {
-                    result |= static_cast<INT_T>(bytes[i+offset]) << (i * 8);
-                }
-            }
+            INT_T result = _unpack_bytes<ENDIANNESS_V>(bytes, std::make_index_sequence<_N_DATA_BYTES>());
 
             if constexpr (N_BITS != _N_CONTAINER_BITS)
             {
@@ -232,9 +566,9 @@ namespace NumIO
                 if constexpr (std::is_signed_v<INT_T>)
                 {
                     // Sign extend the result number if number should be negative
-                    static constexpr unsigned int MSB = endianness_offset ? _N_ALIGN_BYTES : _N_DATA_BYTES - 1;
-                    static constexpr std::uint8_t SIGN_BIT_MASK = (1 << ((N_BITS % 8) + 7) % 8);
-                    if (bytes[MSB+offset] & SIGN_BIT_MASK)
+                    constexpr unsigned int MSB = endianness_offset ? _N_ALIGN_BYTES : _N_DATA_BYTES - 1;
+                    constexpr std::uint8_t SIGN_BIT_MASK = (1 << ((N_BITS % 8) + 7) % 8);
+                    if (bytes[MSB] & SIGN_BIT_MASK)
                         result |= ~_VALUE_MASK;
                 }
             }
@@ -242,176 +576,545 @@ namespace NumIO
             return result;
         }
 
+        ///
+        /// @brief Unpacks an integer from an array of bytes. Usable in constant expressions.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param bytes Array holding the packed data.
+        /// @return Integer value.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static constexpr INT_T unpack(const std::array<std::uint8_t, N_IO_BYTES>& bytes)
+        { return unpack<ENDIANNESS_V>(bytes.data()); }
+
         ///
         /// @brief Unpacks an integer from a vector of bytes.
         ///
         /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam BYTE_T Byte type of the vector: `std::uint8_t`, `std::int8_t`, `char` or `std::byte`.
+        /// @tparam ALLOC_T Allocator type of the vector, e.g. `std::pmr::polymorphic_allocator` for `std::pmr::vector`.
         /// @param bytes Vector of bytes to read from.
         /// @param offset Offset in bytes to extract from of the vector.
         /// @return Integer value.
         ///
-        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
-        static INT_T unpack(std::vector<std::int8_t>& bytes, const unsigned int offset=0)
-        { return unpack<ENDIANNESS_V>(*reinterpret_cast<std::vector<std::uint8_t>*>(&bytes), offset); }
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename BYTE_T, typename ALLOC_T,
+                 typename=__enable_if_byte_t<BYTE_T>>
+        static INT_T unpack(const std::vector<BYTE_T, ALLOC_T>& bytes, const unsigned int offset=0)
+        {
+            #ifdef NUMIO_CHECK_BOUNDS
+                if (offset > bytes.size() || bytes.size() - offset < static_cast<std::size_t>(N_IO_BYTES))
+                    throw std::runtime_error("Offset exceeds the bounds of the vector!");
+            #endif
+            return unpack<ENDIANNESS_V>(reinterpret_cast<const std::uint8_t*>(bytes.data()) + offset);
+        }
 
 
         // :: PACKING FUNCTIONS :: //
         public:
 
         ///
-        /// @brief Packs an integer from a vector of bytes.
+        /// @brief Packs an integer into a buffer of bytes.
         ///
         /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
         /// @param value Input integer value.
-        /// @param bytes Vector of bytes to write to.
+        /// @param bytes Pointer to the first byte to write to. Exactly `N_IO_BYTES` bytes are written.
         ///
         template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
-        static void pack(INT_T value, std::vector<std::uint8_t>& bytes)
+        static constexpr void pack(INT_T value, std::uint8_t* bytes)
         {
-            // Extend vector for packed data
-            auto offset = bytes.size();
-            bytes.resize(offset+N_IO_BYTES);
-
             // Isolate the bits that we're interested in
             value &= _VALUE_MASK;
 
             constexpr auto endianness_offset = _get_endianness_offset(ENDIANNESS_V);
 
-            // Copy the bits into the byte vector
+            // Copy the bits into the byte buffer
             if constexpr (endianness_offset) // Reversed order
             {
-                for (short i=0; i<_N_DATA_BYTES; i++)
-                    bytes[endianness_offset-i] = static_cast<std::uint8_t>((value >> (i * 8)) & 0xFF);
+                _pack_bytes<ENDIANNESS_V>(value, bytes, std::make_index_sequence<_N_DATA_BYTES>());
+                // Clear padding bytes
+                _clear_bytes(bytes, std::make_index_sequence<_N_ALIGN_BYTES>());
             }
             else
-            {
-                for (short i=0; i<N_IO_BYTES; i++)
-                    bytes[i] = static_cast<std::uint8_t>((value >> (i * 8)) & 0xFF);
-            }
+                _pack_bytes<ENDIANNESS_V>(value, bytes, std::make_index_sequence<N_IO_BYTES>());
 
             return;
         }
 
         ///
-        /// @brief Packs an integer from a vector of bytes.
+        /// @brief Packs an integer into an array of bytes. Usable in constant expressions, e.g. to define tables of
+        /// packed constants.
         ///
         /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
         /// @param value Input integer value.
-        /// @param bytes Vector of bytes to write to.
+        /// @return Array holding the packed data.
         ///
         template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
-        static void pack(INT_T value, std::vector<std::int8_t>& bytes)
-        { pack<ENDIANNESS_V>(value, *reinterpret_cast<std::vector<std::uint8_t>*>(&bytes)); }
+        static constexpr std::array<std::uint8_t, N_IO_BYTES> pack_array(INT_T value)
+        {
+            std::array<std::uint8_t, N_IO_BYTES> bytes = {};
+            pack<ENDIANNESS_V>(value, bytes.data());
+            return bytes;
+        }
+
+        ///
+        /// @brief Packs an integer, appending it to a vector of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam BYTE_T Byte type of the vector: `std::uint8_t`, `std::int8_t`, `char` or `std::byte`.
+        /// @tparam ALLOC_T Allocator type of the vector, e.g. `std::pmr::polymorphic_allocator` for `std::pmr::vector`.
+        /// @param value Input integer value.
+        /// @param bytes Vector of bytes to write to.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename BYTE_T, typename ALLOC_T,
+                 typename=__enable_if_byte_t<BYTE_T>>
+        static void pack(INT_T value, std::vector<BYTE_T, ALLOC_T>& bytes)
+        {
+            // Extend vector for packed data
+            auto offset = bytes.size();
+            bytes.resize(offset+N_IO_BYTES);
 
+            pack<ENDIANNESS_V>(value, reinterpret_cast<std::uint8_t*>(bytes.data()) + offset);
 
-        // :: I/O FUNCTIONS :: //
+            return;
+        }
+
+
+        // :: BATCH FUNCTIONS :: //
         public:
 
         ///
-        /// @brief Reads an integer from a binary stream.
+        /// @brief Unpacks consecutive integers from a buffer of bytes. The buffer is not bounds checked.
         ///
         /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
-        /// @param s Binary stream to read from.
-        /// @return Integer value.
+        /// @param bytes Pointer to the first byte of the packed data.
+        /// @param count Amount of values to unpack.
+        /// @param out Output buffer receiving `count` integer values.
+        /// @param stride Distance in bytes between the starts of consecutive values, e.g. the frame size of
+        ///        interleaved data. Defaults to `N_IO_BYTES`.
         ///
         template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
-        static INT_T read(std::istream& s)
+        static void unpack(const std::uint8_t* bytes, std::size_t count, INT_T* out, std::size_t stride=N_IO_BYTES)
         {
-            std::vector<std::uint8_t> buffer(N_IO_BYTES);
-            s.read(reinterpret_cast<char*>(buffer.data()), N_IO_BYTES);
-            return unpack<ENDIANNESS_V>(buffer, 0);
+            for (std::size_t i=0; i<count; i++)
+                out[i] = unpack<ENDIANNESS_V>(bytes + i * stride);
         }
 
         ///
-        /// @brief Writes an integer to a binary stream.
+        /// @brief Packs consecutive integers into a buffer of bytes.
         ///
         /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
-        /// @param value Input integer value.
-        /// @param s Binary stream to write to.
+        /// @param values Input integer values.
+        /// @param count Amount of values to pack.
+        /// @param bytes Pointer to the first byte to write to.
+        /// @param stride Distance in bytes between the starts of consecutive values, e.g. the frame size of
+        ///        interleaved data. Defaults to `N_IO_BYTES`.
         ///
         template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
-        static void write(INT_T value, std::ostream& s)
+        static void pack(const INT_T* values, std::size_t count, std::uint8_t* bytes, std::size_t stride=N_IO_BYTES)
         {
-            std::vector<std::uint8_t> buffer;
-            buffer.reserve(N_IO_BYTES);
-            pack<ENDIANNESS_V>(value, buffer);
-            s.write(reinterpret_cast<char*>(&buffer[0]), N_IO_BYTES);
-            return;
+            for (std::size_t i=0; i<count; i++)
+                pack<ENDIANNESS_V>(values[i], bytes + i * stride);
         }
-    };
-
-
-    ///
-    /// @brief Template class for doing floating point data I/O.
-    ///
-    /// @tparam FLOAT_T Float type to (un)pack.
-    /// @tparam INT_IO_T Integer type used as intermediate storage for I/O retrieval and storage.
-    /// @tparam N_BITS_EXPONENT Specifies the amount of bits of the exponent part of the floating point data. Defaults to an
-    ///         automatically calculated value if `FLOAT_T` is a built-in type or implements `std::numeric_limits<FLOAT_T>`.
-    /// @tparam N_BITS_FRACTION Specifies the amount of bits of the fraction part of the floating point data. Defaults to an
-    ///         automatically calculated value if `FLOAT_T` is a built-in type or implements `std::numeric_limits<FLOAT_T>`.
-    /// @tparam ALIGNED_V Specifies if the data to (un)pack is aligned to match up with the amount of bytes as used by
-    ///         the intermediate storage type `INT_IO_T`.
-    ///
-    template <typename FLOAT_T,
-              typename INT_IO_T,
-              unsigned int N_BITS_EXPONENT=__get_n_bits_exponent_for_typename<FLOAT_T>(),
-              unsigned int N_BITS_FRACTION=__get_n_bits_fraction_for_typename<FLOAT_T>(),
-              bool ALIGNED_V=NUMIO_DEFAULT_ALIGN_V
-             >
-    class FloatIO
-    {
-        static_assert(std::is_floating_point_v<FLOAT_T>, "Template parameter FLOAT_T must be a float type!");
-        static_assert(std::is_integral_v<INT_IO_T>, "Template parameter INT_IO_T must be an integer type!");
-
-
-        // :: PRIVATE ATTRIBUTES & HELPER FUNCTIONS ::
-        private:
-
-        // Takes care of asserting amount of bits not being more than being able to be stored by FLOAT_T and INT_IO_T
-        using _INTIO_TYPE = IntIO<INT_IO_T, (1+N_BITS_EXPONENT+N_BITS_FRACTION), ALIGNED_V>;
 
-        static constexpr short _N_DATA_BYTES = sizeof(FLOAT_T);
-
-        static constexpr int EXPONENT_MASK = (static_cast<int>(1) << N_BITS_EXPONENT) - 1;
-        static constexpr INT_IO_T FRACTION_MASK = (static_cast<INT_IO_T>(1) << N_BITS_FRACTION) - 1;
+        ///
+        /// @brief Unpacks consecutive integers from a buffer of bytes into a vector.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam ALLOC_T Allocator type of the vector.
+        /// @param bytes Pointer to the first byte of the packed data.
+        /// @param count Amount of values to unpack.
+        /// @param out Vector receiving the integer values. Resized to `count`.
+        /// @param stride Distance in bytes between the starts of consecutive values. Defaults to `N_IO_BYTES`.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename ALLOC_T>
+        static void unpack(const std::uint8_t* bytes, std::size_t count, std::vector<INT_T, ALLOC_T>& out,
+                           std::size_t stride=N_IO_BYTES)
+        {
+            out.resize(count);
+            unpack<ENDIANNESS_V>(bytes, count, out.data(), stride);
+        }
 
-        static constexpr int EXPONENT_BIAS = (static_cast<int>(1) << (N_BITS_EXPONENT - 1)) - 1;
-        static constexpr INT_IO_T FRACTION_DENOMINATOR = FRACTION_MASK + 1;
+        ///
+        /// @brief Packs consecutive integers, appending them to a vector of bytes with a single resize.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam BYTE_T Byte type of the vector: `std::uint8_t`, `std::int8_t`, `char` or `std::byte`.
+        /// @tparam ALLOC_T Allocator type of the vector, e.g. `std::pmr::polymorphic_allocator` for `std::pmr::vector`.
+        /// @param values Input integer values.
+        /// @param count Amount of values to pack.
+        /// @param bytes Vector of bytes to append to.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename BYTE_T, typename ALLOC_T,
+                 typename=__enable_if_byte_t<BYTE_T>>
+        static void pack(const INT_T* values, std::size_t count, std::vector<BYTE_T, ALLOC_T>& bytes)
+        {
+            const std::size_t offset = bytes.size();
+            bytes.resize(offset + count * N_IO_BYTES);
+            pack<ENDIANNESS_V>(values, count, reinterpret_cast<std::uint8_t*>(bytes.data()) + offset);
+        }
 
-        static constexpr int EXPONENT_MAX = EXPONENT_BIAS;
-        static constexpr int EXPONENT_MIN = -EXPONENT_BIAS + 1;
+        ///
+        /// @brief Unpacks integers from scattered element positions in a buffer of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam INDEX_T Integer type of the element indices.
+        /// @param bytes Pointer to the first byte of the packed array.
+        /// @param n_bytes Size of the packed array in bytes.
+        /// @param indices Element indices to unpack, in units of `N_IO_BYTES`.
+        /// @param count Amount of indices.
+        /// @param out Output buffer receiving `count` integer values.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename INDEX_T>
+        static void gather_unpack(const std::uint8_t* bytes, std::size_t n_bytes,
+                                  const INDEX_T* indices, std::size_t count, INT_T* out)
+        {
+            static_assert(std::is_integral_v<INDEX_T>, "Template parameter INDEX_T must be an integer type!");
 
-        static constexpr int MIN_VAL_EXPONENT_NORMALIZED = EXPONENT_MIN - N_BITS_FRACTION - 1; // -1 for normalized
+            std::size_t i = 0;
 
+            #if defined(__AVX2__)
+            if constexpr (sizeof(INDEX_T) == 4) {
+                i = _gather_unpack_avx2<ENDIANNESS_V>(
+                    bytes, n_bytes, reinterpret_cast<const std::uint32_t*>(indices), count, out
+                );
+            }
+            #else
+            (void)n_bytes;
+            #endif
 
-        // :: PUBLIC ATTRIBUTES :: //
-        public:
+            for (; i<count; i++) {
+                if (i + __PREFETCH_DISTANCE < count)
+                    __prefetch_read(bytes + static_cast<std::size_t>(indices[i + __PREFETCH_DISTANCE]) * N_IO_BYTES);
+                out[i] = unpack<ENDIANNESS_V>(bytes + static_cast<std::size_t>(indices[i]) * N_IO_BYTES);
+            }
+        }
 
         ///
-        /// @brief The amount of bytes used for the packed data.
+        /// @brief Unpacks integers from scattered element positions in a vector of bytes.
         ///
-        const static int N_IO_BYTES = _N_DATA_BYTES;
-
-
-        // :: UNPACKING FUNCTIONS :: //
-        public:
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam BYTE_T Byte type of the byte vector: `std::uint8_t`, `std::int8_t`, `char` or `std::byte`.
+        /// @tparam BYTE_ALLOC_T, INDEX_ALLOC_T, VALUE_ALLOC_T Allocator types of the vectors.
+        /// @tparam INDEX_T Integer type of the element indices.
+        /// @param bytes Vector of bytes holding the packed array.
+        /// @param indices Element indices to unpack, in units of `N_IO_BYTES`.
+        /// @param out Vector receiving the integer values. Resized to the amount of indices.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename BYTE_T, typename BYTE_ALLOC_T, typename INDEX_T,
+                 typename INDEX_ALLOC_T, typename VALUE_ALLOC_T, typename=__enable_if_byte_t<BYTE_T>>
+        static void gather_unpack(const std::vector<BYTE_T, BYTE_ALLOC_T>& bytes,
+                                  const std::vector<INDEX_T, INDEX_ALLOC_T>& indices, std::vector<INT_T, VALUE_ALLOC_T>& out)
+        {
+            out.resize(indices.size());
+            gather_unpack<ENDIANNESS_V>(reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size(),
+                                        indices.data(), indices.size(), out.data());
+        }
 
         ///
-        /// @brief Unpacks a float from a vector of bytes.
+        /// @brief Packs integers into scattered element positions in a buffer of bytes.
         ///
         /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
-        /// @param bytes Vector of bytes to read from.
-        /// @param offset Offset in bytes to extract from of the vector.
-        /// @return Float value.
+        /// @tparam INDEX_T Integer type of the element indices.
+        /// @param values Input integer values.
+        /// @param indices Element indices to pack into, in units of `N_IO_BYTES`.
+        /// @param count Amount of values and indices.
+        /// @param bytes Pointer to the first byte of the packed array.
         ///
-        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
-        static FLOAT_T unpack(std::vector<std::uint8_t>& bytes, const unsigned int offset=0)
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename INDEX_T>
+        static void scatter_pack(const INT_T* values, const INDEX_T* indices, std::size_t count, std::uint8_t* bytes)
         {
-            INT_IO_T binary_data = _INTIO_TYPE::template unpack<ENDIANNESS_V>(bytes, offset);
+            static_assert(std::is_integral_v<INDEX_T>, "Template parameter INDEX_T must be an integer type!");
+
+            for (std::size_t i=0; i<count; i++) {
+                if (i + __PREFETCH_DISTANCE < count)
+                    __prefetch_write(bytes + static_cast<std::size_t>(indices[i + __PREFETCH_DISTANCE]) * N_IO_BYTES);
+                pack<ENDIANNESS_V>(values[i], bytes + static_cast<std::size_t>(indices[i]) * N_IO_BYTES);
+            }
+        }
+
+        ///
+        /// @brief Packs integers into scattered element positions in a vector of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam VALUE_ALLOC_T, INDEX_ALLOC_T, BYTE_ALLOC_T Allocator types of the vectors.
+        /// @tparam INDEX_T Integer type of the element indices.
+        /// @tparam BYTE_T Byte type of the byte vector: `std::uint8_t`, `std::int8_t`, `char` or `std::byte`.
+        /// @param values Input integer values.
+        /// @param indices Element indices to pack into, in units of `N_IO_BYTES`.
+        /// @param bytes Vector of bytes holding the packed array. Must be large enough to hold every index.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename VALUE_ALLOC_T, typename INDEX_T,
+                 typename INDEX_ALLOC_T, typename BYTE_T, typename BYTE_ALLOC_T, typename=__enable_if_byte_t<BYTE_T>>
+        static void scatter_pack(const std::vector<INT_T, VALUE_ALLOC_T>& values,
+                                 const std::vector<INDEX_T, INDEX_ALLOC_T>& indices,
+                                 std::vector<BYTE_T, BYTE_ALLOC_T>& bytes)
+        {
+            scatter_pack<ENDIANNESS_V>(values.data(), indices.data(), indices.size(),
+                                       reinterpret_cast<std::uint8_t*>(bytes.data()));
+        }
+
+        ///
+        /// @brief Unpacks consecutive integers from a buffer of bytes, validating the bounds of the whole batch once.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param bytes Pointer to the first byte of the packed data.
+        /// @param n_bytes Amount of readable bytes starting at `bytes`.
+        /// @param count Amount of values to unpack.
+        /// @param out Output buffer receiving `count` integer values.
+        /// @param stride Distance in bytes between the starts of consecutive values. Defaults to `N_IO_BYTES`.
+        /// @throws std::runtime_error If the batch exceeds `n_bytes`. Nothing is unpacked in that case.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static void unpack_checked(const std::uint8_t* bytes, std::size_t n_bytes, std::size_t count, INT_T* out,
+                                   std::size_t stride=N_IO_BYTES)
+        {
+            if (!__is_batch_in_bounds(n_bytes, count, stride, N_IO_BYTES))
+                throw std::runtime_error("Batch exceeds the bounds of the buffer!");
+            unpack<ENDIANNESS_V>(bytes, count, out, stride);
+        }
+
+        ///
+        /// @brief Unpacks consecutive integers from a buffer of bytes if the whole batch lies within its bounds.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param bytes Pointer to the first byte of the packed data.
+        /// @param n_bytes Amount of readable bytes starting at `bytes`.
+        /// @param count Amount of values to unpack.
+        /// @param out Output buffer receiving `count` integer values.
+        /// @param stride Distance in bytes between the starts of consecutive values. Defaults to `N_IO_BYTES`.
+        /// @return False if the batch exceeds `n_bytes`, in which case nothing is unpacked.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static bool try_unpack(const std::uint8_t* bytes, std::size_t n_bytes, std::size_t count, INT_T* out,
+                               std::size_t stride=N_IO_BYTES) noexcept
+        {
+            if (!__is_batch_in_bounds(n_bytes, count, stride, N_IO_BYTES))
+                return false;
+            for (std::size_t i=0; i<count; i++)
+                out[i] = unpack<ENDIANNESS_V>(bytes + i * stride);
+            return true;
+        }
+
+        ///
+        /// @brief Packs consecutive integers into a buffer of bytes, validating the bounds of the whole batch once.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param values Input integer values.
+        /// @param count Amount of values to pack.
+        /// @param bytes Pointer to the first byte to write to.
+        /// @param n_bytes Amount of writable bytes starting at `bytes`.
+        /// @param stride Distance in bytes between the starts of consecutive values. Defaults to `N_IO_BYTES`.
+        /// @throws std::runtime_error If the batch exceeds `n_bytes`. Nothing is packed in that case.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static void pack_checked(const INT_T* values, std::size_t count, std::uint8_t* bytes, std::size_t n_bytes,
+                                 std::size_t stride=N_IO_BYTES)
+        {
+            if (!__is_batch_in_bounds(n_bytes, count, stride, N_IO_BYTES))
+                throw std::runtime_error("Batch exceeds the bounds of the buffer!");
+            pack<ENDIANNESS_V>(values, count, bytes, stride);
+        }
 
-            INT_IO_T fraction_numerator = binary_data & FRACTION_MASK;
-            int exponent = (binary_data >> N_BITS_FRACTION) & EXPONENT_MASK;
+
+        // :: I/O FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Reads an integer from a binary stream.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param s Binary stream to read from.
+        /// @return Integer value.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static INT_T read(std::istream& s)
+        {
+            std::uint8_t buffer[N_IO_BYTES] = {};
+            s.read(reinterpret_cast<char*>(buffer), N_IO_BYTES);
+            return unpack<ENDIANNESS_V>(buffer);
+        }
+
+        ///
+        /// @brief Reads an integer from a binary stream, along with the status of the read.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param s Binary stream to read from.
+        /// @return Status and value. Exceptions thrown by the stream for its state are caught and reported.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static ReadResult<INT_T> try_read(std::istream& s)
+        {
+            std::uint8_t buffer[N_IO_BYTES];
+            const std::size_t n_read = __read_bytes(s, buffer, N_IO_BYTES);
+            if (n_read != static_cast<std::size_t>(N_IO_BYTES))
+                return {__short_read_status(s, n_read), 0};
+            return {ReadStatus::OK, unpack<ENDIANNESS_V>(buffer)};
+        }
+
+        ///
+        /// @brief Reads consecutive integers from a binary stream, in blocks.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param s Binary stream to read from.
+        /// @param out Output buffer receiving up to `count` integer values.
+        /// @param count Amount of values to read.
+        /// @return Amount of whole values read. If less than `count`, the stream state tells why; bytes of a trailing
+        ///         partial value are consumed. Exceptions thrown by the stream for its state are caught.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static std::size_t read(std::istream& s, INT_T* out, std::size_t count)
+        {
+            constexpr std::size_t N_BLOCK_VALUES = __READ_BLOCK_SIZE / N_IO_BYTES;
+            std::uint8_t buffer[N_BLOCK_VALUES * N_IO_BYTES];
+
+            std::size_t n_values = 0;
+            while (n_values < count)
+            {
+                const std::size_t n_request = count - n_values < N_BLOCK_VALUES ? count - n_values : N_BLOCK_VALUES;
+                const std::size_t n_read = __read_bytes(s, buffer, n_request * N_IO_BYTES) / N_IO_BYTES;
+                unpack<ENDIANNESS_V>(buffer, n_read, out + n_values);
+                n_values += n_read;
+                if (n_read != n_request)
+                    break;
+            }
+            return n_values;
+        }
+
+        ///
+        /// @brief Writes an integer to a binary stream.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param value Input integer value.
+        /// @param s Binary stream to write to.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static void write(INT_T value, std::ostream& s)
+        {
+            std::uint8_t buffer[N_IO_BYTES];
+            pack<ENDIANNESS_V>(value, buffer);
+            s.write(reinterpret_cast<char*>(buffer), N_IO_BYTES);
+            return;
+        }
+
+        ///
+        /// @brief Writes consecutive integers to a binary stream, in blocks packed on the stack.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param values Input integer values.
+        /// @param count Amount of values to write.
+        /// @param s Binary stream to write to.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static void write(const INT_T* values, std::size_t count, std::ostream& s)
+        {
+            constexpr std::size_t N_BLOCK_VALUES = __READ_BLOCK_SIZE / N_IO_BYTES;
+            std::uint8_t buffer[N_BLOCK_VALUES * N_IO_BYTES];
+
+            for (std::size_t i=0; i<count; i+=N_BLOCK_VALUES)
+            {
+                const std::size_t n = count - i < N_BLOCK_VALUES ? count - i : N_BLOCK_VALUES;
+                pack<ENDIANNESS_V>(values + i, n, buffer);
+                s.write(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(n * N_IO_BYTES));
+            }
+        }
+    };
+
+
+    ///
+    /// @brief Template class for doing floating point data I/O.
+    ///
+    /// @tparam FLOAT_T Float type to (un)pack.
+    /// @tparam INT_IO_T Integer type used as intermediate storage for I/O retrieval and storage.
+    /// @tparam N_BITS_EXPONENT Specifies the amount of bits of the exponent part of the floating point data. Defaults to an
+    ///         automatically calculated value if `FLOAT_T` is a built-in type or implements `std::numeric_limits<FLOAT_T>`.
+    /// @tparam N_BITS_FRACTION Specifies the amount of bits of the fraction part of the floating point data. Defaults to an
+    ///         automatically calculated value if `FLOAT_T` is a built-in type or implements `std::numeric_limits<FLOAT_T>`.
+    /// @tparam ALIGNED_V Specifies if the data to (un)pack is aligned to match up with the amount of bytes as used by
+    ///         the intermediate storage type `INT_IO_T`.
+    /// @tparam DENORMAL_V Specifies if denormalized values are flushed to zero when packing and/or unpacking. Flushing
+    ///         skips the slow gradual underflow paths, for data where denormalized values are noise.
+    ///
+    template <typename FLOAT_T,
+              typename INT_IO_T,
+              unsigned int N_BITS_EXPONENT=__get_n_bits_exponent_for_typename<FLOAT_T>(),
+              unsigned int N_BITS_FRACTION=__get_n_bits_fraction_for_typename<FLOAT_T>(),
+              bool ALIGNED_V=NUMIO_DEFAULT_ALIGN_V,
+              DenormalMode DENORMAL_V=DenormalMode::PRESERVE
+             >
+    class FloatIO
+    {
+        static_assert(std::is_floating_point_v<FLOAT_T>, "Template parameter FLOAT_T must be a float type!");
+        static_assert(std::is_integral_v<INT_IO_T>, "Template parameter INT_IO_T must be an integer type!");
+
+
+        // :: PRIVATE ATTRIBUTES & HELPER FUNCTIONS ::
+        private:
+
+        // Takes care of asserting amount of bits not being more than being able to be stored by FLOAT_T and INT_IO_T
+        using _INTIO_TYPE = IntIO<INT_IO_T, (1+N_BITS_EXPONENT+N_BITS_FRACTION), ALIGNED_V>;
+
+        static constexpr int EXPONENT_MASK = (static_cast<int>(1) << N_BITS_EXPONENT) - 1;
+        static constexpr INT_IO_T FRACTION_MASK = (static_cast<INT_IO_T>(1) << N_BITS_FRACTION) - 1;
+
+        static constexpr int EXPONENT_BIAS = (static_cast<int>(1) << (N_BITS_EXPONENT - 1)) - 1;
+        static constexpr INT_IO_T FRACTION_DENOMINATOR = FRACTION_MASK + 1;
+
+        static constexpr int EXPONENT_MAX = EXPONENT_BIAS;
+        static constexpr int EXPONENT_MIN = -EXPONENT_BIAS + 1;
+
+        static constexpr int MIN_VAL_EXPONENT_NORMALIZED = EXPONENT_MIN - N_BITS_FRACTION - 1; // -1 for normalized
+
+        static constexpr bool _IS_FTZ = DENORMAL_V == DenormalMode::FTZ || DENORMAL_V == DenormalMode::FTZ_DAZ;
+        static constexpr bool _IS_DAZ = DENORMAL_V == DenormalMode::DAZ || DENORMAL_V == DenormalMode::FTZ_DAZ;
+
+
+        // :: PUBLIC ATTRIBUTES :: //
+        public:
+
+        ///
+        /// @brief The amount of bytes used for the packed data.
+        ///
+        static constexpr int N_IO_BYTES = _INTIO_TYPE::N_IO_BYTES;
+
+        ///
+        /// @brief The amount of exponent bits of the float format.
+        ///
+        static constexpr unsigned int N_EXPONENT_BITS = N_BITS_EXPONENT;
+
+        ///
+        /// @brief The amount of fraction bits of the float format.
+        ///
+        static constexpr unsigned int N_FRACTION_BITS = N_BITS_FRACTION;
+
+        ///
+        /// @brief Handling of denormalized values.
+        ///
+        static constexpr DenormalMode DENORMAL_MODE = DENORMAL_V;
+
+        ///
+        /// @brief Float container type.
+        ///
+        using value_type = FLOAT_T;
+
+        ///
+        /// @brief Integer I/O type used as intermediate storage for the binary representation.
+        ///
+        using int_io_type = _INTIO_TYPE;
+
+
+        // :: CONVERSION FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Decodes a float from its binary representation.
+        ///
+        /// @param binary_data Sign, exponent and fraction bits of the float format, as retrieved by the integer I/O.
+        /// @return Float value.
+        ///
+        static constexpr FLOAT_T decode(INT_IO_T binary_data)
+        {
+            INT_IO_T fraction_numerator = binary_data & FRACTION_MASK;
+            int exponent = (binary_data >> N_BITS_FRACTION) & EXPONENT_MASK;
 
             // Multiply result with this to make negative if sign bit set
             int apply_sign = 1 - (
@@ -429,13 +1132,20 @@ namespace NumIO
                 return std::numeric_limits<FLOAT_T>::quiet_NaN();
             }
 
+            // Denormals-are-zero, which also avoids computing a tiny power of two
+            if constexpr (_IS_DAZ) {
+                if (exponent == 0)
+                    return static_cast<FLOAT_T>(apply_sign) * static_cast<FLOAT_T>(0);
+            }
+
             // If the exponent is all zeros, but the mantissa is not then the value is a denormalized number.
             // This means this number does not have an assumed leading one before the binary point.
             int denormalized_adjust = (exponent != 0) & 1;
 
 
-            FLOAT_T result = (
-                std::pow(2.0, -EXPONENT_BIAS + exponent + 1 - denormalized_adjust) // or use math.exp2(x)
+            using CALC_T = std::common_type_t<FLOAT_T, double>;
+            FLOAT_T result = static_cast<FLOAT_T>(
+                __pow2<CALC_T>(-EXPONENT_BIAS + exponent + 1 - denormalized_adjust)
                 * (denormalized_adjust + static_cast<FLOAT_T>(fraction_numerator)/FRACTION_DENOMINATOR)
                 * apply_sign
             );
@@ -443,42 +1153,34 @@ namespace NumIO
             return result;
         }
 
-        ///
-        /// @brief Unpacks a float from a vector of bytes.
-        ///
-        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
-        /// @param bytes Vector of bytes to read from.
-        /// @param offset Offset in bytes to extract from of the vector.
-        /// @return Float value.
-        ///
-        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
-        static FLOAT_T unpack(std::vector<std::int8_t>& bytes, const unsigned int offset=0)
-        { return unpack<ENDIANNESS_V>(*reinterpret_cast<std::vector<std::uint8_t>*>(&bytes), offset); }
 
+        // :: PRIVATE CONVERSION FUNCTIONS :: //
+        private:
 
-        // :: PACKING FUNCTIONS :: //
-        public:
+        // Binary representation of an overflowed value of the given sign
+        template <OverflowPolicy POLICY_V>
+        static constexpr INT_IO_T _overflow_bits(int sign)
+        {
+            const INT_IO_T sign_bits = static_cast<INT_IO_T>(sign) << (N_BITS_EXPONENT + N_BITS_FRACTION);
+            if constexpr (POLICY_V == OverflowPolicy::SATURATE)
+                return sign_bits | (static_cast<INT_IO_T>(EXPONENT_MASK - 1) << N_BITS_FRACTION) | FRACTION_MASK;
+            else
+                return sign_bits | (static_cast<INT_IO_T>(EXPONENT_MASK) << N_BITS_FRACTION);
+        }
 
-        ///
-        /// @brief Packs a float from a vector of bytes.
-        ///
-        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
-        /// @param value Input float value.
-        /// @param bytes Vector of bytes to write to.
-        ///
-        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
-        static void pack(FLOAT_T value, std::vector<std::uint8_t>& bytes)
+        template <OverflowPolicy POLICY_V, RoundingMode ROUNDING_V=RoundingMode::NEAREST_EVEN>
+        static constexpr INT_IO_T _encode(FLOAT_T value, bool& is_overflow, std::uint64_t random_bits=0)
         {
             int sign = 0;
             int exponent = 0; // int since frexp() expects int as argument. No floating point format comes close to needing more than 32 bits for exponent
             INT_IO_T fraction_numerator = 0;
 
             // Special values
-            if (std::isinf(value)) {
+            if (value > std::numeric_limits<FLOAT_T>::max() || value < -std::numeric_limits<FLOAT_T>::max()) {
                 exponent = EXPONENT_MASK;
                 sign = (value < 0) & 1;
             }
-            else if (std::isnan(value)) {
+            else if (value != value) {
                 exponent = EXPONENT_MASK;
                 // Topmost bit of the fraction is used to set non-signaling/quiet NaN. Signaling NaNs would've
                 // caused exceptions in the program, handled by the FPU. All other bits stay 0
@@ -487,7 +1189,7 @@ namespace NumIO
             // Note that this condition captures both 0.0 and -0.0
             else if (value == 0.0) {
                 // Use copysign to differentiate between 0.0 and -0.0
-                sign = (std::copysign(1.0, value) < 0) & 1; // Ruby .negative? or similar also works
+                sign = __is_negative(value) & 1;
             }
             // Non-special values
             else
@@ -502,7 +1204,7 @@ namespace NumIO
                     sign = 0;
                 }
 
-                FLOAT_T fraction = std::frexp(value, &exponent);
+                FLOAT_T fraction = __frexp(value, exponent);
                 if (fraction < 0.5 || fraction >= 1.0) {
                     throw std::runtime_error("frexp() result out of range!");
                 }
@@ -512,16 +1214,25 @@ namespace NumIO
                 exponent -= 1;
 
                 if (exponent > EXPONENT_MAX) {
-                    throw std::runtime_error("The floating point value is too large to be packed into the designated format!");
+                    if constexpr (POLICY_V == OverflowPolicy::THROW)
+                        throw std::runtime_error("The floating point value is too large to be packed into the designated format!");
+                    is_overflow = true;
+                    return _overflow_bits<POLICY_V>(sign);
+                }
+                else if (_IS_FTZ && exponent < EXPONENT_MIN) {
+                    // Flush-to-zero, keeping the sign
+                    fraction = 0;
+                    exponent = 0;
                 }
-                else if (exponent < MIN_VAL_EXPONENT_NORMALIZED) {
-                    // Underflow to zero
+                else if (exponent < MIN_VAL_EXPONENT_NORMALIZED && ROUNDING_V != RoundingMode::STOCHASTIC) {
+                    // Underflow to zero. Stochastic rounding takes the gradual underflow path, as any nonzero value
+                    // has a chance of rounding up to the smallest denormalized value
                     fraction = 0;
                     exponent = 0;
                 }
                 else if (exponent < EXPONENT_MIN) {
                     // Gradual underflow
-                    fraction = std::ldexp(fraction, -EXPONENT_MIN + exponent);
+                    fraction *= __pow2<FLOAT_T>(-EXPONENT_MIN + exponent);
                     exponent = 0;
                 }
                 else if (!(exponent == 0 && fraction == 0.0)) {
@@ -534,17 +1245,33 @@ namespace NumIO
 
                 fraction *= FRACTION_DENOMINATOR; // Turn into fractional numerator
                 fraction_numerator = static_cast<INT_IO_T>(fraction); // Truncate numerator, can also use floor() but probably slower
-                // Round to even
-                if ((fraction - fraction_numerator > 0.5) ||
-                    ((fraction - fraction_numerator == 0.5) && (fraction_numerator % 2 == 1))
-                ) {
+
+                // Remainder below the numerator as 64-bit fixed point, with the lowest bit set if any bits beyond are
+                // set, so that the rounding decisions below are exact integer comparisons
+                const FLOAT_T scaled_remainder = (fraction - fraction_numerator) * __pow2<FLOAT_T>(64);
+                std::uint64_t remainder = static_cast<std::uint64_t>(scaled_remainder);
+                remainder |= static_cast<std::uint64_t>(scaled_remainder != static_cast<FLOAT_T>(remainder));
+
+                constexpr std::uint64_t HALF = static_cast<std::uint64_t>(1) << 63;
+                bool is_round_up = false;
+                if constexpr (ROUNDING_V == RoundingMode::NEAREST_EVEN)
+                    is_round_up = remainder > HALF || (remainder == HALF && (fraction_numerator & 1));
+                else if constexpr (ROUNDING_V == RoundingMode::HALF_AWAY)
+                    is_round_up = remainder >= HALF;
+                else if constexpr (ROUNDING_V == RoundingMode::STOCHASTIC)
+                    is_round_up = random_bits < remainder;
+
+                if (is_round_up) {
                     fraction_numerator += 1;
                     if (fraction_numerator == FRACTION_DENOMINATOR) {
                         // Fraction overflows, carry to exponent
                         fraction_numerator = 0;
                         exponent += 1;
                         if (exponent >= EXPONENT_MASK) {
-                            throw std::runtime_error("The floating point value is too large to be packed into the designated format!");
+                            if constexpr (POLICY_V == OverflowPolicy::THROW)
+                                throw std::runtime_error("The floating point value is too large to be packed into the designated format!");
+                            is_overflow = true;
+                            return _overflow_bits<POLICY_V>(sign);
                         }
                     }
                 }
@@ -554,21 +1281,471 @@ namespace NumIO
                                    (static_cast<INT_IO_T>(exponent & EXPONENT_MASK) << N_BITS_FRACTION) |
                                    (fraction_numerator & FRACTION_MASK);
 
-            _INTIO_TYPE::template pack<ENDIANNESS_V>(binary_data, bytes);
+            return binary_data;
+        }
+
 
-            return;
+        // :: CONVERSION FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Encodes a float into its binary representation.
+        ///
+        /// @tparam POLICY_V Defines what to do with values that are too large for the format.
+        /// @param value Input float value.
+        /// @return Sign, exponent and fraction bits of the float format, to be stored by the integer I/O.
+        /// @throws std::runtime_error If the value is too large and `POLICY_V` is `OverflowPolicy::THROW`.
+        ///
+        template<OverflowPolicy POLICY_V=OverflowPolicy::THROW>
+        static constexpr INT_IO_T encode(FLOAT_T value)
+        {
+            bool is_overflow = false;
+            return _encode<POLICY_V>(value, is_overflow);
+        }
+
+        ///
+        /// @brief Encodes a float into its binary representation, reporting overflow instead of throwing.
+        ///
+        /// @tparam POLICY_V Defines what to encode for values that are too large for the format.
+        /// @param value Input float value.
+        /// @param is_overflow Set to true if the value was too large for the format, left untouched otherwise.
+        /// @return Sign, exponent and fraction bits of the float format, to be stored by the integer I/O.
+        ///
+        template<OverflowPolicy POLICY_V=OverflowPolicy::SATURATE>
+        static constexpr INT_IO_T encode(FLOAT_T value, bool& is_overflow) noexcept
+        {
+            static_assert(POLICY_V != OverflowPolicy::THROW, "Overflow policy can't be THROW for non-throwing encoding!");
+            return _encode<POLICY_V>(value, is_overflow);
+        }
+
+        ///
+        /// @brief Encodes a float into its binary representation with a given rounding mode.
+        ///
+        /// @tparam ROUNDING_V Defines how values are rounded to the precision of the format.
+        /// @tparam POLICY_V Defines what to do with values that are too large for the format.
+        /// @param value Input float value.
+        /// @param random_bits Uniformly distributed random bits for `RoundingMode::STOCHASTIC`, ignored otherwise.
+        /// @return Sign, exponent and fraction bits of the float format, to be stored by the integer I/O.
+        /// @throws std::runtime_error If the value is too large and `POLICY_V` is `OverflowPolicy::THROW`.
+        ///
+        template<RoundingMode ROUNDING_V, OverflowPolicy POLICY_V=OverflowPolicy::THROW>
+        static constexpr INT_IO_T encode_rounded(FLOAT_T value, std::uint64_t random_bits=0)
+        {
+            bool is_overflow = false;
+            return _encode<POLICY_V, ROUNDING_V>(value, is_overflow, random_bits);
+        }
+
+
+        // :: UNPACKING FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Unpacks a float from a buffer of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param bytes Pointer to the first byte of the packed data. At least `N_IO_BYTES` bytes must be readable.
+        /// @return Float value.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static constexpr FLOAT_T unpack(const std::uint8_t* bytes)
+        { return decode(_INTIO_TYPE::template unpack<ENDIANNESS_V>(bytes)); }
+
+        ///
+        /// @brief Unpacks a float from an array of bytes. Usable in constant expressions.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param bytes Array holding the packed data.
+        /// @return Float value.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static constexpr FLOAT_T unpack(const std::array<std::uint8_t, N_IO_BYTES>& bytes)
+        { return unpack<ENDIANNESS_V>(bytes.data()); }
+
+        ///
+        /// @brief Unpacks a float from a vector of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam BYTE_T Byte type of the vector: `std::uint8_t`, `std::int8_t`, `char` or `std::byte`.
+        /// @tparam ALLOC_T Allocator type of the vector, e.g. `std::pmr::polymorphic_allocator` for `std::pmr::vector`.
+        /// @param bytes Vector of bytes to read from.
+        /// @param offset Offset in bytes to extract from of the vector.
+        /// @return Float value.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename BYTE_T, typename ALLOC_T,
+                 typename=__enable_if_byte_t<BYTE_T>>
+        static FLOAT_T unpack(const std::vector<BYTE_T, ALLOC_T>& bytes, const unsigned int offset=0)
+        {
+            #ifdef NUMIO_CHECK_BOUNDS
+                if (offset > bytes.size() || bytes.size() - offset < static_cast<std::size_t>(N_IO_BYTES))
+                    throw std::runtime_error("Offset exceeds the bounds of the vector!");
+            #endif
+            return unpack<ENDIANNESS_V>(reinterpret_cast<const std::uint8_t*>(bytes.data()) + offset);
         }
 
+
+        // :: PACKING FUNCTIONS :: //
+        public:
+
         ///
-        /// @brief Packs a float from a vector of bytes.
+        /// @brief Packs a float into a buffer of bytes.
         ///
         /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
         /// @param value Input float value.
+        /// @param bytes Pointer to the first byte to write to. Exactly `N_IO_BYTES` bytes are written.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, OverflowPolicy POLICY_V=OverflowPolicy::THROW>
+        static constexpr void pack(FLOAT_T value, std::uint8_t* bytes)
+        { _INTIO_TYPE::template pack<ENDIANNESS_V>(encode<POLICY_V>(value), bytes); }
+
+        ///
+        /// @brief Packs a float into a buffer of bytes, reporting overflow instead of throwing.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam POLICY_V Defines what to pack for values that are too large for the format.
+        /// @param value Input float value.
+        /// @param bytes Pointer to the first byte to write to. Exactly `N_IO_BYTES` bytes are written.
+        /// @return False if the value was too large for the format.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, OverflowPolicy POLICY_V=OverflowPolicy::SATURATE>
+        static bool try_pack(FLOAT_T value, std::uint8_t* bytes) noexcept
+        {
+            bool is_overflow = false;
+            _INTIO_TYPE::template pack<ENDIANNESS_V>(encode<POLICY_V>(value, is_overflow), bytes);
+            return !is_overflow;
+        }
+
+        ///
+        /// @brief Packs a float into an array of bytes. Usable in constant expressions, e.g. to define tables of
+        /// packed constants.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam POLICY_V Defines what to do with values that are too large for the format.
+        /// @param value Input float value.
+        /// @return Array holding the packed data.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, OverflowPolicy POLICY_V=OverflowPolicy::THROW>
+        static constexpr std::array<std::uint8_t, N_IO_BYTES> pack_array(FLOAT_T value)
+        {
+            std::array<std::uint8_t, N_IO_BYTES> bytes = {};
+            pack<ENDIANNESS_V, POLICY_V>(value, bytes.data());
+            return bytes;
+        }
+
+        ///
+        /// @brief Packs a float, appending it to a vector of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam BYTE_T Byte type of the vector: `std::uint8_t`, `std::int8_t`, `char` or `std::byte`.
+        /// @tparam ALLOC_T Allocator type of the vector, e.g. `std::pmr::polymorphic_allocator` for `std::pmr::vector`.
+        /// @param value Input float value.
         /// @param bytes Vector of bytes to write to.
         ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename BYTE_T, typename ALLOC_T,
+                 typename=__enable_if_byte_t<BYTE_T>>
+        static void pack(FLOAT_T value, std::vector<BYTE_T, ALLOC_T>& bytes)
+        { _INTIO_TYPE::template pack<ENDIANNESS_V>(encode(value), bytes); }
+
+
+        // :: BATCH FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Unpacks consecutive floats from a buffer of bytes. The buffer is not bounds checked.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param bytes Pointer to the first byte of the packed data.
+        /// @param count Amount of values to unpack.
+        /// @param out Output buffer receiving `count` float values.
+        /// @param stride Distance in bytes between the starts of consecutive values, e.g. the frame size of
+        ///        interleaved data. Defaults to `N_IO_BYTES`.
+        ///
         template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
-        static void pack(FLOAT_T value, std::vector<std::int8_t>& bytes)
-        { pack<ENDIANNESS_V>(value, *reinterpret_cast<std::vector<std::uint8_t>*>(&bytes)); }
+        static void unpack(const std::uint8_t* bytes, std::size_t count, FLOAT_T* out, std::size_t stride=N_IO_BYTES)
+        {
+            for (std::size_t i=0; i<count; i++)
+                out[i] = unpack<ENDIANNESS_V>(bytes + i * stride);
+        }
+
+        ///
+        /// @brief Packs consecutive floats into a buffer of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param values Input float values.
+        /// @param count Amount of values to pack.
+        /// @param bytes Pointer to the first byte to write to.
+        /// @param stride Distance in bytes between the starts of consecutive values, e.g. the frame size of
+        ///        interleaved data. Defaults to `N_IO_BYTES`.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, OverflowPolicy POLICY_V=OverflowPolicy::THROW>
+        static void pack(const FLOAT_T* values, std::size_t count, std::uint8_t* bytes, std::size_t stride=N_IO_BYTES)
+        {
+            for (std::size_t i=0; i<count; i++)
+                pack<ENDIANNESS_V, POLICY_V>(values[i], bytes + i * stride);
+        }
+
+        ///
+        /// @brief Unpacks consecutive floats from a buffer of bytes into a vector.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam ALLOC_T Allocator type of the vector.
+        /// @param bytes Pointer to the first byte of the packed data.
+        /// @param count Amount of values to unpack.
+        /// @param out Vector receiving the float values. Resized to `count`.
+        /// @param stride Distance in bytes between the starts of consecutive values. Defaults to `N_IO_BYTES`.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename ALLOC_T>
+        static void unpack(const std::uint8_t* bytes, std::size_t count, std::vector<FLOAT_T, ALLOC_T>& out,
+                           std::size_t stride=N_IO_BYTES)
+        {
+            out.resize(count);
+            unpack<ENDIANNESS_V>(bytes, count, out.data(), stride);
+        }
+
+        ///
+        /// @brief Packs consecutive floats, appending them to a vector of bytes with a single resize.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam BYTE_T Byte type of the vector: `std::uint8_t`, `std::int8_t`, `char` or `std::byte`.
+        /// @tparam ALLOC_T Allocator type of the vector, e.g. `std::pmr::polymorphic_allocator` for `std::pmr::vector`.
+        /// @param values Input float values.
+        /// @param count Amount of values to pack.
+        /// @param bytes Vector of bytes to append to.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename BYTE_T, typename ALLOC_T,
+                 typename=__enable_if_byte_t<BYTE_T>>
+        static void pack(const FLOAT_T* values, std::size_t count, std::vector<BYTE_T, ALLOC_T>& bytes)
+        {
+            const std::size_t offset = bytes.size();
+            bytes.resize(offset + count * N_IO_BYTES);
+            pack<ENDIANNESS_V>(values, count, reinterpret_cast<std::uint8_t*>(bytes.data()) + offset);
+        }
+
+        ///
+        /// @brief Packs consecutive floats into a buffer of bytes, counting overflows instead of throwing.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam POLICY_V Defines what to pack for values that are too large for the format.
+        /// @param values Input float values.
+        /// @param count Amount of values to pack.
+        /// @param bytes Pointer to the first byte to write to.
+        /// @param stride Distance in bytes between the starts of consecutive values, e.g. the frame size of
+        ///        interleaved data. Defaults to `N_IO_BYTES`.
+        /// @return Amount of values that were too large for the format.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, OverflowPolicy POLICY_V=OverflowPolicy::SATURATE>
+        static std::size_t try_pack(const FLOAT_T* values, std::size_t count, std::uint8_t* bytes,
+                                    std::size_t stride=N_IO_BYTES) noexcept
+        {
+            std::size_t n_overflows = 0;
+            for (std::size_t i=0; i<count; i++) {
+                bool is_overflow = false;
+                _INTIO_TYPE::template pack<ENDIANNESS_V>(encode<POLICY_V>(values[i], is_overflow), bytes + i * stride);
+                n_overflows += is_overflow;
+            }
+            return n_overflows;
+        }
+
+        ///
+        /// @brief Packs consecutive floats into a buffer of bytes with a given rounding mode.
+        ///
+        /// For stochastic rounding, the random bits of value `i` are a hash of `seed` and `first_index + i`. As there is
+        /// no generator state, the result doesn't depend on how a sequence is split into batches or threads.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam ROUNDING_V Defines how values are rounded to the precision of the format.
+        /// @tparam POLICY_V Defines what to do with values that are too large for the format.
+        /// @param values Input float values.
+        /// @param count Amount of values to pack.
+        /// @param bytes Pointer to the first byte to write to.
+        /// @param stride Distance in bytes between the starts of consecutive values.
+        /// @param seed Seed for stochastic rounding.
+        /// @param first_index Index of the first value within the whole sequence, for stochastic rounding.
+        /// @throws std::runtime_error If a value is too large and `POLICY_V` is `OverflowPolicy::THROW`.
+        ///
+        template<Endian ENDIANNESS_V, RoundingMode ROUNDING_V, OverflowPolicy POLICY_V=OverflowPolicy::THROW>
+        static void pack_rounded(const FLOAT_T* values, std::size_t count, std::uint8_t* bytes,
+                                 std::size_t stride=N_IO_BYTES, std::uint64_t seed=0, std::uint64_t first_index=0)
+        {
+            for (std::size_t i=0; i<count; i++) {
+                const std::uint64_t random_bits = ROUNDING_V == RoundingMode::STOCHASTIC
+                    ? __mix64(__mix64(seed) + first_index + i)
+                    : 0;
+                _INTIO_TYPE::template pack<ENDIANNESS_V>(encode_rounded<ROUNDING_V, POLICY_V>(values[i], random_bits),
+                                                         bytes + i * stride);
+            }
+        }
+
+        ///
+        /// @brief Packs consecutive floats into a buffer of bytes with a rounding mode selected at runtime.
+        ///
+        /// @see `pack_rounded()` with the rounding mode as template parameter.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, OverflowPolicy POLICY_V=OverflowPolicy::THROW>
+        static void pack_rounded(RoundingMode rounding, const FLOAT_T* values, std::size_t count, std::uint8_t* bytes,
+                                 std::size_t stride=N_IO_BYTES, std::uint64_t seed=0, std::uint64_t first_index=0)
+        {
+            switch (rounding) {
+                case RoundingMode::NEAREST_EVEN:
+                    return pack_rounded<ENDIANNESS_V, RoundingMode::NEAREST_EVEN, POLICY_V>(values, count, bytes, stride);
+                case RoundingMode::TOWARD_ZERO:
+                    return pack_rounded<ENDIANNESS_V, RoundingMode::TOWARD_ZERO, POLICY_V>(values, count, bytes, stride);
+                case RoundingMode::HALF_AWAY:
+                    return pack_rounded<ENDIANNESS_V, RoundingMode::HALF_AWAY, POLICY_V>(values, count, bytes, stride);
+                case RoundingMode::STOCHASTIC:
+                    return pack_rounded<ENDIANNESS_V, RoundingMode::STOCHASTIC, POLICY_V>(values, count, bytes, stride, seed, first_index);
+            }
+        }
+
+        ///
+        /// @brief Unpacks floats from scattered element positions in a buffer of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam INDEX_T Integer type of the element indices.
+        /// @param bytes Pointer to the first byte of the packed array.
+        /// @param n_bytes Size of the packed array in bytes.
+        /// @param indices Element indices to unpack, in units of `N_IO_BYTES`.
+        /// @param count Amount of indices.
+        /// @param out Output buffer receiving `count` float values.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename INDEX_T>
+        static void gather_unpack(const std::uint8_t* bytes, std::size_t n_bytes,
+                                  const INDEX_T* indices, std::size_t count, FLOAT_T* out)
+        {
+            static_assert(std::is_integral_v<INDEX_T>, "Template parameter INDEX_T must be an integer type!");
+            (void)n_bytes;
+
+            for (std::size_t i=0; i<count; i++) {
+                if (i + __PREFETCH_DISTANCE < count)
+                    __prefetch_read(bytes + static_cast<std::size_t>(indices[i + __PREFETCH_DISTANCE]) * N_IO_BYTES);
+                out[i] = unpack<ENDIANNESS_V>(bytes + static_cast<std::size_t>(indices[i]) * N_IO_BYTES);
+            }
+        }
+
+        ///
+        /// @brief Unpacks floats from scattered element positions in a vector of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam BYTE_T Byte type of the byte vector: `std::uint8_t`, `std::int8_t`, `char` or `std::byte`.
+        /// @tparam BYTE_ALLOC_T, INDEX_ALLOC_T, VALUE_ALLOC_T Allocator types of the vectors.
+        /// @tparam INDEX_T Integer type of the element indices.
+        /// @param bytes Vector of bytes holding the packed array.
+        /// @param indices Element indices to unpack, in units of `N_IO_BYTES`.
+        /// @param out Vector receiving the float values. Resized to the amount of indices.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename BYTE_T, typename BYTE_ALLOC_T, typename INDEX_T,
+                 typename INDEX_ALLOC_T, typename VALUE_ALLOC_T, typename=__enable_if_byte_t<BYTE_T>>
+        static void gather_unpack(const std::vector<BYTE_T, BYTE_ALLOC_T>& bytes,
+                                  const std::vector<INDEX_T, INDEX_ALLOC_T>& indices, std::vector<FLOAT_T, VALUE_ALLOC_T>& out)
+        {
+            out.resize(indices.size());
+            gather_unpack<ENDIANNESS_V>(reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size(),
+                                        indices.data(), indices.size(), out.data());
+        }
+
+        ///
+        /// @brief Packs floats into scattered element positions in a buffer of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam INDEX_T Integer type of the element indices.
+        /// @param values Input float values.
+        /// @param indices Element indices to pack into, in units of `N_IO_BYTES`.
+        /// @param count Amount of values and indices.
+        /// @param bytes Pointer to the first byte of the packed array.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename INDEX_T>
+        static void scatter_pack(const FLOAT_T* values, const INDEX_T* indices, std::size_t count, std::uint8_t* bytes)
+        {
+            static_assert(std::is_integral_v<INDEX_T>, "Template parameter INDEX_T must be an integer type!");
+
+            for (std::size_t i=0; i<count; i++) {
+                if (i + __PREFETCH_DISTANCE < count)
+                    __prefetch_write(bytes + static_cast<std::size_t>(indices[i + __PREFETCH_DISTANCE]) * N_IO_BYTES);
+                pack<ENDIANNESS_V>(values[i], bytes + static_cast<std::size_t>(indices[i]) * N_IO_BYTES);
+            }
+        }
+
+        ///
+        /// @brief Packs floats into scattered element positions in a vector of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam VALUE_ALLOC_T, INDEX_ALLOC_T, BYTE_ALLOC_T Allocator types of the vectors.
+        /// @tparam INDEX_T Integer type of the element indices.
+        /// @tparam BYTE_T Byte type of the byte vector: `std::uint8_t`, `std::int8_t`, `char` or `std::byte`.
+        /// @param values Input float values.
+        /// @param indices Element indices to pack into, in units of `N_IO_BYTES`.
+        /// @param bytes Vector of bytes holding the packed array. Must be large enough to hold every index.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename VALUE_ALLOC_T, typename INDEX_T,
+                 typename INDEX_ALLOC_T, typename BYTE_T, typename BYTE_ALLOC_T, typename=__enable_if_byte_t<BYTE_T>>
+        static void scatter_pack(const std::vector<FLOAT_T, VALUE_ALLOC_T>& values,
+                                 const std::vector<INDEX_T, INDEX_ALLOC_T>& indices,
+                                 std::vector<BYTE_T, BYTE_ALLOC_T>& bytes)
+        {
+            scatter_pack<ENDIANNESS_V>(values.data(), indices.data(), indices.size(),
+                                       reinterpret_cast<std::uint8_t*>(bytes.data()));
+        }
+
+        ///
+        /// @brief Unpacks consecutive floats from a buffer of bytes, validating the bounds of the whole batch once.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param bytes Pointer to the first byte of the packed data.
+        /// @param n_bytes Amount of readable bytes starting at `bytes`.
+        /// @param count Amount of values to unpack.
+        /// @param out Output buffer receiving `count` float values.
+        /// @param stride Distance in bytes between the starts of consecutive values. Defaults to `N_IO_BYTES`.
+        /// @throws std::runtime_error If the batch exceeds `n_bytes`. Nothing is unpacked in that case.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static void unpack_checked(const std::uint8_t* bytes, std::size_t n_bytes, std::size_t count, FLOAT_T* out,
+                                   std::size_t stride=N_IO_BYTES)
+        {
+            if (!__is_batch_in_bounds(n_bytes, count, stride, N_IO_BYTES))
+                throw std::runtime_error("Batch exceeds the bounds of the buffer!");
+            unpack<ENDIANNESS_V>(bytes, count, out, stride);
+        }
+
+        ///
+        /// @brief Unpacks consecutive floats from a buffer of bytes if the whole batch lies within its bounds.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param bytes Pointer to the first byte of the packed data.
+        /// @param n_bytes Amount of readable bytes starting at `bytes`.
+        /// @param count Amount of values to unpack.
+        /// @param out Output buffer receiving `count` float values.
+        /// @param stride Distance in bytes between the starts of consecutive values. Defaults to `N_IO_BYTES`.
+        /// @return False if the batch exceeds `n_bytes`, in which case nothing is unpacked.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static bool try_unpack(const std::uint8_t* bytes, std::size_t n_bytes, std::size_t count, FLOAT_T* out,
+                               std::size_t stride=N_IO_BYTES) noexcept
+        {
+            if (!__is_batch_in_bounds(n_bytes, count, stride, N_IO_BYTES))
+                return false;
+            for (std::size_t i=0; i<count; i++)
+                out[i] = unpack<ENDIANNESS_V>(bytes + i * stride);
+            return true;
+        }
+
+        ///
+        /// @brief Packs consecutive floats into a buffer of bytes, validating the bounds of the whole batch once.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param values Input float values.
+        /// @param count Amount of values to pack.
+        /// @param bytes Pointer to the first byte to write to.
+        /// @param n_bytes Amount of writable bytes starting at `bytes`.
+        /// @param stride Distance in bytes between the starts of consecutive values. Defaults to `N_IO_BYTES`.
+        /// @throws std::runtime_error If the batch exceeds `n_bytes`. Nothing is packed in that case.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static void pack_checked(const FLOAT_T* values, std::size_t count, std::uint8_t* bytes, std::size_t n_bytes,
+                                 std::size_t stride=N_IO_BYTES)
+        {
+            if (!__is_batch_in_bounds(n_bytes, count, stride, N_IO_BYTES))
+                throw std::runtime_error("Batch exceeds the bounds of the buffer!");
+            pack<ENDIANNESS_V>(values, count, bytes, stride);
+        }
 
 
         // :: I/O FUNCTIONS :: //
@@ -584,9 +1761,55 @@ namespace NumIO
         template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
         static FLOAT_T read(std::istream& s)
         {
-            std::vector<std::uint8_t> buffer(N_IO_BYTES);
-            s.read(reinterpret_cast<char*>(buffer.data()), N_IO_BYTES);
-            return unpack<ENDIANNESS_V>(buffer, 0);
+            std::uint8_t buffer[N_IO_BYTES] = {};
+            s.read(reinterpret_cast<char*>(buffer), N_IO_BYTES);
+            return unpack<ENDIANNESS_V>(buffer);
+        }
+
+        ///
+        /// @brief Reads a float from a binary stream, along with the status of the read.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param s Binary stream to read from.
+        /// @return Status and value. Exceptions thrown by the stream for its state are caught and reported.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static ReadResult<FLOAT_T> try_read(std::istream& s)
+        {
+            std::uint8_t buffer[N_IO_BYTES];
+            const std::size_t n_read = __read_bytes(s, buffer, N_IO_BYTES);
+            if (n_read != static_cast<std::size_t>(N_IO_BYTES))
+                return {__short_read_status(s, n_read), 0};
+            return {ReadStatus::OK, unpack<ENDIANNESS_V>(buffer)};
+        }
+
+        ///
+        /// @brief Reads consecutive floats from a binary stream, in blocks.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param s Binary stream to read from.
+        /// @param out Output buffer receiving up to `count` float values.
+        /// @param count Amount of values to read.
+        /// @return Amount of whole values read. If less than `count`, the stream state tells why; bytes of a trailing
+        ///         partial value are consumed. Exceptions thrown by the stream for its state are caught.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static std::size_t read(std::istream& s, FLOAT_T* out, std::size_t count)
+        {
+            constexpr std::size_t N_BLOCK_VALUES = __READ_BLOCK_SIZE / N_IO_BYTES;
+            std::uint8_t buffer[N_BLOCK_VALUES * N_IO_BYTES];
+
+            std::size_t n_values = 0;
+            while (n_values < count)
+            {
+                const std::size_t n_request = count - n_values < N_BLOCK_VALUES ? count - n_values : N_BLOCK_VALUES;
+                const std::size_t n_read = __read_bytes(s, buffer, n_request * N_IO_BYTES) / N_IO_BYTES;
+                unpack<ENDIANNESS_V>(buffer, n_read, out + n_values);
+                n_values += n_read;
+                if (n_read != n_request)
+                    break;
+            }
+            return n_values;
         }
 
         ///
@@ -599,12 +1822,33 @@ namespace NumIO
         template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
         static void write(FLOAT_T value, std::ostream& s)
         {
-            std::vector<std::uint8_t> buffer;
-            buffer.reserve(N_IO_BYTES);
+            std::uint8_t buffer[N_IO_BYTES];
             pack<ENDIANNESS_V>(value, buffer);
-            s.write(reinterpret_cast<char*>(&buffer[0]), N_IO_BYTES);
+            s.write(reinterpret_cast<char*>(buffer), N_IO_BYTES);
             return;
         }
+
+        ///
+        /// @brief Writes consecutive floats to a binary stream, in blocks packed on the stack.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param values Input float values.
+        /// @param count Amount of values to write.
+        /// @param s Binary stream to write to.
+        ///
+        template<Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static void write(const FLOAT_T* values, std::size_t count, std::ostream& s)
+        {
+            constexpr std::size_t N_BLOCK_VALUES = __READ_BLOCK_SIZE / N_IO_BYTES;
+            std::uint8_t buffer[N_BLOCK_VALUES * N_IO_BYTES];
+
+            for (std::size_t i=0; i<count; i+=N_BLOCK_VALUES)
+            {
+                const std::size_t n = count - i < N_BLOCK_VALUES ? count - i : N_BLOCK_VALUES;
+                pack<ENDIANNESS_V>(values + i, n, buffer);
+                s.write(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(n * N_IO_BYTES));
+            }
+        }
     };
 
 }
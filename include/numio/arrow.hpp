@@ -0,0 +1,280 @@
+#ifndef NUMIO_ARROW_H
+#define NUMIO_ARROW_H
+
+// ****************************************************************************
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../numio.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    namespace {
+        // Alignment and padding recommended by the Arrow columnar format
+        static constexpr std::size_t __ARROW_ALIGNMENT = 64;
+    }
+
+    ///
+    /// @brief Heap buffer aligned to 64 bytes, with its capacity padded to a multiple of 64 bytes.
+    ///
+    class AlignedBuffer
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        std::uint8_t* _data = nullptr;
+        std::size_t _size = 0;
+
+
+        // :: CONSTRUCTORS & DESTRUCTOR :: //
+        public:
+
+        ///
+        /// @brief Constructs an empty buffer.
+        ///
+        AlignedBuffer() = default;
+
+        ///
+        /// @brief Allocates a buffer. The padding after `size` bytes is zeroed.
+        ///
+        /// @param size Size of the buffer in bytes.
+        ///
+        explicit AlignedBuffer(std::size_t size)
+            : _size(size)
+        {
+            if (!size)
+                return;
+            const std::size_t capacity = (size + __ARROW_ALIGNMENT - 1) / __ARROW_ALIGNMENT * __ARROW_ALIGNMENT;
+            _data = static_cast<std::uint8_t*>(::operator new(capacity, std::align_val_t(__ARROW_ALIGNMENT)));
+            std::memset(_data + size, 0, capacity - size);
+        }
+
+        AlignedBuffer(const AlignedBuffer&) = delete;
+        AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+        AlignedBuffer(AlignedBuffer&& other) noexcept
+            : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0))
+        {}
+
+        AlignedBuffer& operator=(AlignedBuffer&& other) noexcept
+        {
+            if (this != &other) {
+                _free();
+                _data = std::exchange(other._data, nullptr);
+                _size = std::exchange(other._size, 0);
+            }
+            return *this;
+        }
+
+        ~AlignedBuffer()
+        { _free(); }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns a pointer to the first byte, or a null pointer if empty.
+        ///
+        std::uint8_t* data()
+        { return _data; }
+
+        const std::uint8_t* data() const
+        { return _data; }
+
+        ///
+        /// @brief Returns the size of the buffer in bytes, excluding padding.
+        ///
+        std::size_t size() const
+        { return _size; }
+
+        ///
+        /// @brief Releases ownership of the memory, e.g. to hand it to an Arrow consumer. The memory must be freed
+        /// with `AlignedBuffer::free()`.
+        ///
+        std::uint8_t* release()
+        {
+            _size = 0;
+            return std::exchange(_data, nullptr);
+        }
+
+        ///
+        /// @brief Frees memory obtained through `release()`.
+        ///
+        static void free(void* data)
+        {
+            if (data)
+                ::operator delete(data, std::align_val_t(__ARROW_ALIGNMENT));
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        void _free()
+        {
+            free(_data);
+            _data = nullptr;
+            _size = 0;
+        }
+    };
+
+
+    ///
+    /// @brief Fixed-width primitive column in the Arrow columnar memory layout: a values buffer and an optional
+    /// validity bitmap, both 64-byte aligned and padded.
+    ///
+    /// @tparam T Value type.
+    ///
+    template <typename T>
+    struct ArrowColumn
+    {
+        /// Values, one `T` per slot. Slots that are null hold their decoded value.
+        AlignedBuffer values;
+        /// Validity bitmap in LSB bit order (1 = valid). Empty when there are no nulls.
+        AlignedBuffer validity;
+        /// Amount of slots.
+        std::size_t length = 0;
+        /// Amount of null slots.
+        std::size_t null_count = 0;
+
+        ///
+        /// @brief Returns the format string of the Arrow C data interface, e.g. `"i"` for `std::int32_t`.
+        ///
+        static constexpr const char* format()
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return "f";
+            else if constexpr (std::is_same_v<T, double>)
+                return "g";
+            else if constexpr (sizeof(T) == 1)
+                return std::is_signed_v<T> ? "c" : "C";
+            else if constexpr (sizeof(T) == 2)
+                return std::is_signed_v<T> ? "s" : "S";
+            else if constexpr (sizeof(T) == 4)
+                return std::is_signed_v<T> ? "i" : "I";
+            else
+                return std::is_signed_v<T> ? "l" : "L";
+        }
+
+        ///
+        /// @brief Returns a pointer to the values.
+        ///
+        const T* data() const
+        { return reinterpret_cast<const T*>(values.data()); }
+
+        ///
+        /// @brief Returns the buffers as expected by `ArrowArray::buffers`: the validity bitmap (null if there are no
+        /// nulls) followed by the values.
+        ///
+        std::array<const void*, 2> buffers() const
+        { return {null_count ? validity.data() : nullptr, values.data()}; }
+
+        ///
+        /// @brief Checks if a slot holds a value.
+        ///
+        bool is_valid(std::size_t index) const
+        { return !null_count || ((validity.data()[index / 8] >> (index % 8)) & 1); }
+    };
+
+
+    ///
+    /// @brief Template class for decoding packed values directly into Arrow columns.
+    ///
+    /// @tparam IO_T `IntIO` or `FloatIO` type of the packed values. The column holds its `value_type`, so e.g.
+    ///         `NumIO::i24_IO` results in an `int32` column and `NumIO::fp16_IO` in a `float` column.
+    ///
+    template <typename IO_T>
+    class ArrowExport
+    {
+        // :: PRIVATE ATTRIBUTES & HELPER FUNCTIONS :: //
+        private:
+
+        using _T = typename IO_T::value_type;
+        static_assert(std::is_arithmetic_v<_T> && sizeof(_T) <= 8, "Value type is not an Arrow primitive type!");
+
+        static bool _is_null(_T value, _T sentinel)
+        {
+            if constexpr (std::is_floating_point_v<_T>) {
+                if (std::isnan(sentinel))
+                    return std::isnan(value);
+            }
+            return value == sentinel;
+        }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Decodes packed values into a column without nulls.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data.
+        /// @param bytes Pointer to the first byte of the packed values.
+        /// @param count Amount of values.
+        /// @param stride Distance in bytes between the starts of consecutive values.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static ArrowColumn<_T> decode(const std::uint8_t* bytes, std::size_t count, std::size_t stride=IO_T::N_IO_BYTES)
+        {
+            ArrowColumn<_T> column;
+            column.length = count;
+            column.values = AlignedBuffer(count * sizeof(_T));
+            IO_T::template unpack<ENDIANNESS_V>(bytes, count, reinterpret_cast<_T*>(column.values.data()), stride);
+            return column;
+        }
+
+        ///
+        /// @brief Decodes packed values into a column, marking slots equal to a sentinel value as null.
+        ///
+        /// The validity bitmap is only allocated if at least one null is found.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data.
+        /// @param bytes Pointer to the first byte of the packed values.
+        /// @param count Amount of values.
+        /// @param null_sentinel Value representing null. For floats, a NaN sentinel marks every NaN as null.
+        /// @param stride Distance in bytes between the starts of consecutive values.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static ArrowColumn<_T> decode_nullable(const std::uint8_t* bytes, std::size_t count, _T null_sentinel,
+                                               std::size_t stride=IO_T::N_IO_BYTES)
+        {
+            ArrowColumn<_T> column = decode<ENDIANNESS_V>(bytes, count, stride);
+            const _T* values = column.data();
+
+            // Build the bitmap a byte at a time, only keeping it once a null shows up
+            AlignedBuffer validity((count + 7) / 8);
+            std::uint8_t* bitmap = validity.data();
+            std::size_t n_valid = 0;
+            for (std::size_t i=0; i<count; i+=8)
+            {
+                const std::size_t n = std::min<std::size_t>(8, count - i);
+                std::uint8_t bits = 0;
+                for (std::size_t j=0; j<n; j++) {
+                    const bool is_valid = !_is_null(values[i + j], null_sentinel);
+                    bits |= static_cast<std::uint8_t>(is_valid) << j;
+                    n_valid += is_valid;
+                }
+                bitmap[i / 8] = bits;
+            }
+
+            column.null_count = count - n_valid;
+            if (column.null_count)
+                column.validity = std::move(validity);
+            return column;
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_ARROW_H */
@@ -0,0 +1,683 @@
+#ifndef NUMIO_CHUNKED_H
+#define NUMIO_CHUNKED_H
+
+// ****************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../numio.hpp"
+#include "mmap.hpp"
+#include "pool.hpp"
+#include "std.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    namespace {
+        static constexpr char __CHUNKED_MAGIC[8] = {'N', 'U', 'M', 'I', 'O', 'C', 'H', 'K'};
+        static constexpr char __CHUNKED_INDEX_MAGIC[8] = {'N', 'U', 'M', 'I', 'O', 'I', 'D', 'X'};
+        static constexpr std::uint16_t __CHUNKED_VERSION = 1;
+        static constexpr std::size_t __CHUNKED_HEADER_SIZE = 64;
+        static constexpr std::size_t __CHUNKED_INDEX_ENTRY_SIZE = 48;
+        static constexpr std::size_t __CHUNKED_FOOTER_SIZE = 24;
+        // Minimum value (8 bytes) and bit width (1 byte) preceding bit-packed values
+        static constexpr std::size_t __CHUNKED_BIT_PACKED_HEADER_SIZE = 9;
+    }
+
+    ///
+    /// @brief Encodings of the chunks of a chunked array file.
+    ///
+    enum class ChunkEncoding : std::uint8_t
+    {
+        /// Packed values as is.
+        RAW        = 0,
+        /// Packed values with their bytes transposed: the first byte of every value, then the second byte, etc.
+        /// Improves the ratio of general purpose compressors applied on top of the file.
+        SHUFFLED   = 1,
+        /// Integer values stored as their difference to the minimum of the chunk, in the least amount of bits.
+        BIT_PACKED = 2,
+    };
+
+    ///
+    /// @brief Describes the format of the values of a chunked array file.
+    ///
+    struct ChunkedDescriptor
+    {
+        /// Kind of the values: `'i'` for signed integers, `'u'` for unsigned integers and `'f'` for floats.
+        char kind = 'i';
+        /// Total amount of bits of a value, including the sign bit.
+        unsigned int n_value_bits = 0;
+        /// Amount of exponent bits of floats, 0 for integers.
+        unsigned int n_exponent_bits = 0;
+        /// Amount of fraction bits of floats, 0 for integers.
+        unsigned int n_fraction_bits = 0;
+        /// Amount of bytes of a packed value, including alignment padding.
+        unsigned int n_io_bytes = 0;
+        /// Byte order of the packed values.
+        Endian endianness = Endian::LITTLE;
+
+        ///
+        /// @brief Returns the descriptor of an IO type in a given byte order.
+        ///
+        /// @tparam IO_T `IntIO` or `FloatIO` type.
+        ///
+        template <typename IO_T>
+        static ChunkedDescriptor of(Endian endianness=Endian::LITTLE)
+        {
+            using T = typename IO_T::value_type;
+            ChunkedDescriptor descriptor;
+            if constexpr (std::is_floating_point_v<T>) {
+                descriptor.kind = 'f';
+                descriptor.n_exponent_bits = IO_T::N_EXPONENT_BITS;
+                descriptor.n_fraction_bits = IO_T::N_FRACTION_BITS;
+                descriptor.n_value_bits = 1 + IO_T::N_EXPONENT_BITS + IO_T::N_FRACTION_BITS;
+            }
+            else {
+                descriptor.kind = std::is_signed_v<T> ? 'i' : 'u';
+                descriptor.n_value_bits = IO_T::N_VALUE_BITS;
+            }
+            descriptor.n_io_bytes = IO_T::N_IO_BYTES;
+            descriptor.endianness = endianness;
+            return descriptor;
+        }
+
+        ///
+        /// @brief Checks if packed values are padded to a larger container size.
+        ///
+        bool is_aligned() const
+        { return n_io_bytes * 8 >= n_value_bits + 8; }
+
+        bool operator==(const ChunkedDescriptor& other) const
+        {
+            return kind == other.kind && n_value_bits == other.n_value_bits && n_exponent_bits == other.n_exponent_bits
+                && n_fraction_bits == other.n_fraction_bits && n_io_bytes == other.n_io_bytes
+                && endianness == other.endianness;
+        }
+
+        bool operator!=(const ChunkedDescriptor& other) const
+        { return !(*this == other); }
+    };
+
+    ///
+    /// @brief Index entry of a chunk of a chunked array file.
+    ///
+    /// @tparam T Value type of the array.
+    ///
+    template <typename T>
+    struct ChunkInfo
+    {
+        /// Offset of the encoded chunk in the file.
+        std::uint64_t offset = 0;
+        /// Size of the encoded chunk in bytes.
+        std::uint64_t n_bytes = 0;
+        /// Amount of values in the chunk.
+        std::uint64_t count = 0;
+        /// Encoding of the chunk.
+        ChunkEncoding encoding = ChunkEncoding::RAW;
+        /// Smallest value of the chunk, ignoring NaN.
+        T min = 0;
+        /// Largest value of the chunk, ignoring NaN.
+        T max = 0;
+    };
+
+
+    ///
+    /// @brief Writer of chunked array files.
+    ///
+    /// A chunked array file consists of a 64-byte header holding the `ChunkedDescriptor` and chunk size, the encoded
+    /// chunks, and a trailing index with the location, encoding and minimum/maximum of every chunk. All chunks hold
+    /// `chunk_size` values, except for the last one. Values are buffered until a chunk is complete. The index is
+    /// written by `finalize()`, which is also called by the destructor.
+    ///
+    /// @tparam IO_T `IntIO` or `FloatIO` type of the values, e.g. `NumIO::i24_IO`.
+    /// @tparam ENDIANNESS_V Byte order of the packed values.
+    ///
+    template <typename IO_T, Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+    class ChunkedWriter
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        using _T = typename IO_T::value_type;
+
+        std::ostream& _stream;
+        std::size_t _chunk_size;
+        ChunkEncoding _encoding;
+        std::uint64_t _offset;
+        std::vector<_T> _pending;
+        std::vector<ChunkInfo<_T>> _index;
+        std::vector<std::uint8_t> _buffer;
+        std::vector<std::uint8_t> _encoded;
+        bool _is_finalized;
+
+
+        // :: CONSTRUCTORS & DESTRUCTOR :: //
+        public:
+
+        ///
+        /// @brief Constructs a writer and writes the file header.
+        ///
+        /// @param stream Binary output stream, positioned at the start of the file.
+        /// @param chunk_size Amount of values per chunk.
+        /// @param encoding Encoding of the chunks. Can be changed between chunks with `set_encoding()`.
+        /// @throws std::runtime_error If the chunk size is zero or the encoding is not supported for the value type.
+        ///
+        ChunkedWriter(std::ostream& stream, std::size_t chunk_size, ChunkEncoding encoding=ChunkEncoding::RAW)
+            : _stream(stream), _chunk_size(chunk_size), _encoding(ChunkEncoding::RAW),
+              _offset(__CHUNKED_HEADER_SIZE), _is_finalized(false)
+        {
+            if (chunk_size == 0)
+                throw std::runtime_error("Chunk size must not be zero!");
+            set_encoding(encoding);
+            _pending.reserve(chunk_size);
+
+            const ChunkedDescriptor descriptor = ChunkedDescriptor::of<IO_T>(ENDIANNESS_V);
+            std::uint8_t header[__CHUNKED_HEADER_SIZE] = {};
+            std::memcpy(header, __CHUNKED_MAGIC, sizeof(__CHUNKED_MAGIC));
+            u16_IO::pack<Endian::LITTLE>(__CHUNKED_VERSION, header + 8);
+            header[10] = static_cast<std::uint8_t>(descriptor.kind);
+            header[11] = static_cast<std::uint8_t>(descriptor.endianness == Endian::BIG);
+            u16_IO::pack<Endian::LITTLE>(static_cast<std::uint16_t>(descriptor.n_value_bits), header + 12);
+            u16_IO::pack<Endian::LITTLE>(static_cast<std::uint16_t>(descriptor.n_exponent_bits), header + 14);
+            u16_IO::pack<Endian::LITTLE>(static_cast<std::uint16_t>(descriptor.n_fraction_bits), header + 16);
+            u16_IO::pack<Endian::LITTLE>(static_cast<std::uint16_t>(descriptor.n_io_bytes), header + 18);
+            u64_IO::pack<Endian::LITTLE>(chunk_size, header + 24);
+            _stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+        }
+
+        ChunkedWriter(const ChunkedWriter&) = delete;
+        ChunkedWriter& operator=(const ChunkedWriter&) = delete;
+
+        ~ChunkedWriter()
+        {
+            try { finalize(); }
+            catch (...) {}
+        }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Sets the encoding of the chunks written from now on.
+        ///
+        /// @throws std::runtime_error If bit-packing is requested for floats.
+        ///
+        void set_encoding(ChunkEncoding encoding)
+        {
+            if (encoding == ChunkEncoding::BIT_PACKED && std::is_floating_point_v<_T>)
+                throw std::runtime_error("Bit-packing is only supported for integer values!");
+            _encoding = encoding;
+        }
+
+        ///
+        /// @brief Appends values to the array.
+        ///
+        /// @param values Pointer to the first value.
+        /// @param count Amount of values.
+        ///
+        void write(const _T* values, std::size_t count)
+        {
+            if (_is_finalized)
+                throw std::runtime_error("Chunked array file is already finalized!");
+
+            while (count)
+            {
+                // Complete chunks are encoded straight from the input
+                if (_pending.empty() && count >= _chunk_size) {
+                    _write_chunk(values, _chunk_size);
+                    values += _chunk_size;
+                    count -= _chunk_size;
+                    continue;
+                }
+
+                std::size_t n = std::min(count, _chunk_size - _pending.size());
+                _pending.insert(_pending.end(), values, values + n);
+                values += n;
+                count -= n;
+                if (_pending.size() == _chunk_size) {
+                    _write_chunk(_pending.data(), _pending.size());
+                    _pending.clear();
+                }
+            }
+        }
+
+        ///
+        /// @brief Appends values to the array.
+        ///
+        void write(const std::vector<_T>& values)
+        { write(values.data(), values.size()); }
+
+        ///
+        /// @brief Writes the last incomplete chunk and the index. No values can be written afterwards.
+        ///
+        void finalize()
+        {
+            if (_is_finalized)
+                return;
+            _is_finalized = true;
+
+            if (!_pending.empty())
+                _write_chunk(_pending.data(), _pending.size());
+
+            std::vector<std::uint8_t> index(_index.size() * __CHUNKED_INDEX_ENTRY_SIZE + __CHUNKED_FOOTER_SIZE, 0);
+            std::uint8_t* entry = index.data();
+            for (const auto& info : _index)
+            {
+                u64_IO::pack<Endian::LITTLE>(info.offset, entry);
+                u64_IO::pack<Endian::LITTLE>(info.n_bytes, entry + 8);
+                u64_IO::pack<Endian::LITTLE>(info.count, entry + 16);
+                entry[24] = static_cast<std::uint8_t>(info.encoding);
+                _pack_stat(info.min, entry + 32);
+                _pack_stat(info.max, entry + 40);
+                entry += __CHUNKED_INDEX_ENTRY_SIZE;
+            }
+            u64_IO::pack<Endian::LITTLE>(_offset, entry);
+            u64_IO::pack<Endian::LITTLE>(_index.size(), entry + 8);
+            std::memcpy(entry + 16, __CHUNKED_INDEX_MAGIC, sizeof(__CHUNKED_INDEX_MAGIC));
+
+            _stream.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+            _stream.flush();
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        // Statistics are stored as 64-bit integers or doubles
+        static void _pack_stat(_T value, std::uint8_t* bytes)
+        {
+            if constexpr (std::is_floating_point_v<_T>)
+                fp64_IO::pack<Endian::LITTLE>(static_cast<double>(value), bytes);
+            else if constexpr (std::is_signed_v<_T>)
+                i64_IO::pack<Endian::LITTLE>(static_cast<std::int64_t>(value), bytes);
+            else
+                u64_IO::pack<Endian::LITTLE>(static_cast<std::uint64_t>(value), bytes);
+        }
+
+        void _write_chunk(const _T* values, std::size_t count)
+        {
+            ChunkInfo<_T> info;
+            info.offset = _offset;
+            info.count = count;
+            info.encoding = _encoding;
+
+            // Statistics, ignoring NaN
+            bool has_value = false;
+            for (std::size_t i=0; i<count; i++) {
+                if constexpr (std::is_floating_point_v<_T>) {
+                    if (std::isnan(values[i]))
+                        continue;
+                }
+                info.min = has_value ? std::min(info.min, values[i]) : values[i];
+                info.max = has_value ? std::max(info.max, values[i]) : values[i];
+                has_value = true;
+            }
+            if constexpr (std::is_floating_point_v<_T>) {
+                if (!has_value)
+                    info.min = info.max = std::numeric_limits<_T>::quiet_NaN();
+            }
+
+            const std::uint8_t* data = nullptr;
+            if (_encoding == ChunkEncoding::BIT_PACKED)
+            {
+                if constexpr (!std::is_floating_point_v<_T>) {
+                    _bit_pack(values, count, info.min, info.max);
+                    data = _encoded.data();
+                    info.n_bytes = _encoded.size();
+                }
+            }
+            else
+            {
+                _buffer.resize(count * IO_T::N_IO_BYTES);
+                IO_T::template pack<ENDIANNESS_V>(values, count, _buffer.data());
+                data = _buffer.data();
+                info.n_bytes = _buffer.size();
+
+                if (_encoding == ChunkEncoding::SHUFFLED) {
+                    _encoded.resize(_buffer.size());
+                    for (std::size_t i=0; i<count; i++) {
+                        for (std::size_t b=0; b<static_cast<std::size_t>(IO_T::N_IO_BYTES); b++)
+                            _encoded[b * count + i] = _buffer[i * IO_T::N_IO_BYTES + b];
+                    }
+                    data = _encoded.data();
+                }
+            }
+
+            _stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(info.n_bytes));
+            _offset += info.n_bytes;
+            _index.push_back(info);
+        }
+
+        void _bit_pack(const _T* values, std::size_t count, _T min, _T max)
+        {
+            // Differences are computed in 64-bit two's complement, which can't overflow
+            const std::uint64_t base = static_cast<std::uint64_t>(static_cast<std::int64_t>(min));
+            const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max)) - base;
+            unsigned int width = 0;
+            while (width < 64 && (range >> width))
+                width++;
+
+            const std::size_t n_bytes = (static_cast<std::uint64_t>(count) * width + 7) / 8;
+            _encoded.assign(__CHUNKED_BIT_PACKED_HEADER_SIZE + n_bytes + 8, 0);
+            u64_IO::pack<Endian::LITTLE>(base, _encoded.data());
+            _encoded[8] = static_cast<std::uint8_t>(width);
+
+            // Little endian bit stream, flushed 8 bytes at a time
+            std::uint8_t* out = _encoded.data() + __CHUNKED_BIT_PACKED_HEADER_SIZE;
+            std::uint64_t accumulator = 0;
+            unsigned int n_bits = 0;
+            if (width) {
+                for (std::size_t i=0; i<count; i++)
+                {
+                    const std::uint64_t delta = static_cast<std::uint64_t>(static_cast<std::int64_t>(values[i])) - base;
+                    accumulator |= delta << n_bits;
+                    if (n_bits + width >= 64) {
+                        u64_IO::pack<Endian::LITTLE>(accumulator, out);
+                        out += 8;
+                        accumulator = n_bits ? delta >> (64 - n_bits) : 0;
+                        n_bits = n_bits + width - 64;
+                    }
+                    else
+                        n_bits += width;
+                }
+            }
+            for (unsigned int shift=0; shift<n_bits; shift+=8)
+                *out++ = static_cast<std::uint8_t>(accumulator >> shift);
+
+            _encoded.resize(__CHUNKED_BIT_PACKED_HEADER_SIZE + n_bytes);
+        }
+    };
+
+
+    ///
+    /// @brief Reader of chunked array files, as written by `ChunkedWriter`.
+    ///
+    /// The file is memory mapped and the index is read when opening. Chunks are decoded independently, so scans can
+    /// skip chunks by their statistics, and `read_chunk()` may be called concurrently from multiple threads.
+    ///
+    /// @tparam IO_T `IntIO` or `FloatIO` type of the values. Must match the descriptor of the file, except for the byte
+    ///         order, which is handled at runtime.
+    ///
+    template <typename IO_T>
+    class ChunkedReader
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        using _T = typename IO_T::value_type;
+
+        MappedFile _file;
+        ChunkedDescriptor _descriptor;
+        std::size_t _chunk_size;
+        std::size_t _size;
+        std::vector<ChunkInfo<_T>> _index;
+
+
+        // :: CONSTRUCTORS :: //
+        public:
+
+        ///
+        /// @brief Opens a chunked array file by memory mapping it, and reads its index.
+        ///
+        /// @param path Path of the file to open.
+        /// @throws std::runtime_error If the file can't be mapped, is malformed or doesn't match `IO_T`.
+        ///
+        explicit ChunkedReader(const std::string& path)
+            : _file(path), _chunk_size(0), _size(0)
+        {
+            const std::uint8_t* bytes = _file.data();
+            const std::size_t size = _file.size();
+            if (size < __CHUNKED_HEADER_SIZE + __CHUNKED_FOOTER_SIZE
+                || std::memcmp(bytes, __CHUNKED_MAGIC, sizeof(__CHUNKED_MAGIC)) != 0
+                || std::memcmp(bytes + size - 8, __CHUNKED_INDEX_MAGIC, sizeof(__CHUNKED_INDEX_MAGIC)) != 0)
+                throw std::runtime_error("Data is not a chunked array file!");
+            if (u16_IO::unpack<Endian::LITTLE>(bytes + 8) != __CHUNKED_VERSION)
+                throw std::runtime_error("Chunked array file version is not supported!");
+
+            _descriptor.kind = static_cast<char>(bytes[10]);
+            _descriptor.endianness = bytes[11] ? Endian::BIG : Endian::LITTLE;
+            _descriptor.n_value_bits = u16_IO::unpack<Endian::LITTLE>(bytes + 12);
+            _descriptor.n_exponent_bits = u16_IO::unpack<Endian::LITTLE>(bytes + 14);
+            _descriptor.n_fraction_bits = u16_IO::unpack<Endian::LITTLE>(bytes + 16);
+            _descriptor.n_io_bytes = u16_IO::unpack<Endian::LITTLE>(bytes + 18);
+            _chunk_size = static_cast<std::size_t>(u64_IO::unpack<Endian::LITTLE>(bytes + 24));
+            if (_descriptor != ChunkedDescriptor::of<IO_T>(_descriptor.endianness))
+                throw std::runtime_error("Chunked array file does not match the requested IO type!");
+            if (_chunk_size == 0)
+                throw std::runtime_error("Chunked array file has a chunk size of zero!");
+
+            // Sizes are validated by subtracting from known sizes, so that crafted values can't wrap around
+            const std::uint8_t* footer = bytes + size - __CHUNKED_FOOTER_SIZE;
+            const std::uint64_t index_offset = u64_IO::unpack<Endian::LITTLE>(footer);
+            const std::uint64_t n_chunks = u64_IO::unpack<Endian::LITTLE>(footer + 8);
+            const std::size_t max_index_size = size - __CHUNKED_HEADER_SIZE - __CHUNKED_FOOTER_SIZE;
+            if (n_chunks > max_index_size / __CHUNKED_INDEX_ENTRY_SIZE
+                || index_offset != size - __CHUNKED_FOOTER_SIZE - n_chunks * __CHUNKED_INDEX_ENTRY_SIZE)
+                throw std::runtime_error("Chunked array file index is malformed!");
+
+            _index.resize(static_cast<std::size_t>(n_chunks));
+            const std::uint8_t* entry = bytes + index_offset;
+            for (std::size_t c=0; c<_index.size(); c++)
+            {
+                ChunkInfo<_T>& info = _index[c];
+                info.offset = u64_IO::unpack<Endian::LITTLE>(entry);
+                info.n_bytes = u64_IO::unpack<Endian::LITTLE>(entry + 8);
+                info.count = u64_IO::unpack<Endian::LITTLE>(entry + 16);
+                info.encoding = static_cast<ChunkEncoding>(entry[24]);
+                info.min = _unpack_stat(entry + 32);
+                info.max = _unpack_stat(entry + 40);
+                if (info.offset < __CHUNKED_HEADER_SIZE || info.offset > index_offset
+                    || info.n_bytes > index_offset - info.offset)
+                    throw std::runtime_error("Chunked array file index is malformed!");
+                // Reads locate values by dividing by the chunk size, so only the last chunk may be partial
+                const bool is_last = c + 1 == _index.size();
+                if (is_last ? info.count == 0 || info.count > _chunk_size : info.count != _chunk_size)
+                    throw std::runtime_error("Chunked array file index is malformed!");
+                _size += static_cast<std::size_t>(info.count);
+                entry += __CHUNKED_INDEX_ENTRY_SIZE;
+            }
+        }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns the descriptor of the values.
+        ///
+        const ChunkedDescriptor& descriptor() const
+        { return _descriptor; }
+
+        ///
+        /// @brief Returns the amount of values per chunk (except the last one).
+        ///
+        std::size_t chunk_size() const
+        { return _chunk_size; }
+
+        ///
+        /// @brief Returns the total amount of values.
+        ///
+        std::size_t size() const
+        { return _size; }
+
+        ///
+        /// @brief Returns the index entries of all chunks.
+        ///
+        const std::vector<ChunkInfo<_T>>& chunks() const
+        { return _index; }
+
+        ///
+        /// @brief Decodes all values of a chunk.
+        ///
+        /// @param chunk Index of the chunk.
+        /// @param out Pointer to write `chunks()[chunk].count` values to.
+        /// @throws std::runtime_error If the chunk is malformed.
+        ///
+        void read_chunk(std::size_t chunk, _T* out) const
+        {
+            const ChunkInfo<_T>& info = _index.at(chunk);
+            if (_descriptor.endianness == Endian::LITTLE)
+                _decode<Endian::LITTLE>(info, out);
+            else
+                _decode<Endian::BIG>(info, out);
+        }
+
+        ///
+        /// @brief Decodes a range of values, only touching the chunks that hold them.
+        ///
+        /// @param first Index of the first value.
+        /// @param count Amount of values.
+        /// @param out Pointer to write the values to.
+        /// @throws std::out_of_range If the range is out of bounds.
+        ///
+        void read(std::size_t first, std::size_t count, _T* out) const
+        {
+            if (first + count > _size)
+                throw std::out_of_range("Chunked array range is out of bounds!");
+
+            std::vector<_T> buffer;
+            std::size_t chunk = first / _chunk_size;
+            std::size_t skip = first % _chunk_size;
+            while (count)
+            {
+                const std::size_t n = std::min<std::size_t>(count, static_cast<std::size_t>(_index[chunk].count) - skip);
+                if (skip == 0 && n == _index[chunk].count) {
+                    read_chunk(chunk, out);
+                }
+                else {
+                    buffer.resize(static_cast<std::size_t>(_index[chunk].count));
+                    read_chunk(chunk, buffer.data());
+                    std::copy(buffer.begin() + skip, buffer.begin() + skip + n, out);
+                }
+                out += n;
+                count -= n;
+                skip = 0;
+                chunk++;
+            }
+        }
+
+        ///
+        /// @brief Decodes all values into a vector.
+        ///
+        std::vector<_T> to_vector() const
+        {
+            std::vector<_T> result(_size);
+            read(0, _size, result.data());
+            return result;
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        static _T _unpack_stat(const std::uint8_t* bytes)
+        {
+            if constexpr (std::is_floating_point_v<_T>)
+                return static_cast<_T>(fp64_IO::unpack<Endian::LITTLE>(bytes));
+            else if constexpr (std::is_signed_v<_T>)
+                return static_cast<_T>(i64_IO::unpack<Endian::LITTLE>(bytes));
+            else
+                return static_cast<_T>(u64_IO::unpack<Endian::LITTLE>(bytes));
+        }
+
+        template <Endian ENDIANNESS_V>
+        void _decode(const ChunkInfo<_T>& info, _T* out) const
+        {
+            const std::uint8_t* bytes = _file.data() + info.offset;
+            const std::size_t count = static_cast<std::size_t>(info.count);
+
+            switch (info.encoding)
+            {
+                case ChunkEncoding::RAW:
+                {
+                    if (info.n_bytes != count * IO_T::N_IO_BYTES)
+                        throw std::runtime_error("Chunked array chunk is malformed!");
+                    IO_T::template unpack<ENDIANNESS_V>(bytes, count, out);
+                    break;
+                }
+                case ChunkEncoding::SHUFFLED:
+                {
+                    if (info.n_bytes != count * IO_T::N_IO_BYTES)
+                        throw std::runtime_error("Chunked array chunk is malformed!");
+                    BufferPool::Buffer buffer = BufferPool::local().acquire(static_cast<std::size_t>(info.n_bytes));
+                    for (std::size_t b=0; b<static_cast<std::size_t>(IO_T::N_IO_BYTES); b++) {
+                        for (std::size_t i=0; i<count; i++)
+                            buffer.data()[i * IO_T::N_IO_BYTES + b] = bytes[b * count + i];
+                    }
+                    IO_T::template unpack<ENDIANNESS_V>(buffer.data(), count, out);
+                    break;
+                }
+                case ChunkEncoding::BIT_PACKED:
+                {
+                    if constexpr (std::is_floating_point_v<_T>)
+                        throw std::runtime_error("Chunked array chunk is malformed!");
+                    else
+                        _bit_unpack(bytes, static_cast<std::size_t>(info.n_bytes), count, out);
+                    break;
+                }
+                default:
+                    throw std::runtime_error("Chunked array chunk encoding is not supported!");
+            }
+        }
+
+        static void _bit_unpack(const std::uint8_t* bytes, std::size_t n_bytes, std::size_t count, _T* out)
+        {
+            if (n_bytes < __CHUNKED_BIT_PACKED_HEADER_SIZE)
+                throw std::runtime_error("Chunked array chunk is malformed!");
+            const std::uint64_t base = u64_IO::unpack<Endian::LITTLE>(bytes);
+            const unsigned int width = bytes[8];
+            if (width > 64 || n_bytes != __CHUNKED_BIT_PACKED_HEADER_SIZE + (static_cast<std::uint64_t>(count) * width + 7) / 8)
+                throw std::runtime_error("Chunked array chunk is malformed!");
+
+            const std::uint64_t mask = width == 64 ? ~static_cast<std::uint64_t>(0) : (static_cast<std::uint64_t>(1) << width) - 1;
+            const std::uint8_t* in = bytes + __CHUNKED_BIT_PACKED_HEADER_SIZE;
+            const std::uint8_t* end = bytes + n_bytes;
+
+            // Mirror of the writer: refill the accumulator 8 bytes at a time (fewer at the end of the stream)
+            std::uint64_t accumulator = 0;
+            unsigned int n_bits = 0;
+            for (std::size_t i=0; i<count; i++)
+            {
+                std::uint64_t delta;
+                if (n_bits >= width) {
+                    delta = accumulator & mask;
+                    accumulator = width == 64 ? 0 : accumulator >> width;
+                    n_bits -= width;
+                }
+                else {
+                    std::uint64_t next = 0;
+                    unsigned int n_loaded = 0;
+                    if (end - in >= 8) {
+                        next = u64_IO::unpack<Endian::LITTLE>(in);
+                        n_loaded = 64;
+                    }
+                    else {
+                        for (; in + n_loaded / 8 < end; n_loaded += 8)
+                            next |= static_cast<std::uint64_t>(in[n_loaded / 8]) << n_loaded;
+                    }
+                    in += n_loaded / 8;
+                    delta = (accumulator | (next << n_bits)) & mask;
+                    const unsigned int n_used = width - n_bits;
+                    accumulator = n_used >= 64 ? 0 : next >> n_used;
+                    n_bits = n_loaded - n_used;
+                }
+                out[i] = static_cast<_T>(static_cast<std::int64_t>(base + delta));
+            }
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_CHUNKED_H */
@@ -0,0 +1,451 @@
+#ifndef NUMIO_FITS_H
+#define NUMIO_FITS_H
+
+// ****************************************************************************
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../numio.hpp"
+#include "mmap.hpp"
+#include "std.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    namespace {
+        static constexpr std::size_t __FITS_BLOCK_SIZE = 2880;
+        static constexpr std::size_t __FITS_CARD_SIZE = 80;
+
+        static std::string __fits_trim(const std::string& s)
+        {
+            std::size_t begin = s.find_first_not_of(' ');
+            if (begin == std::string::npos)
+                return "";
+            return s.substr(begin, s.find_last_not_of(' ') - begin + 1);
+        }
+
+        // Multiplies sizes taken from a header, which could otherwise wrap to a small size
+        static std::size_t __fits_multiply(std::size_t a, std::size_t b)
+        {
+            if (a != 0 && b > std::numeric_limits<std::size_t>::max() / a)
+                throw std::runtime_error("FITS data size is too large!");
+            return a * b;
+        }
+    }
+
+    ///
+    /// @brief Header and data location of a single header data unit (HDU) of a FITS file.
+    ///
+    class FitsHdu
+    {
+        friend class FitsReader;
+
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        std::map<std::string, std::string> _keywords;
+        const std::uint8_t* _data = nullptr;
+        std::size_t _data_size = 0;
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Checks if the header contains a keyword.
+        ///
+        bool has(const std::string& keyword) const
+        { return _keywords.count(keyword) != 0; }
+
+        ///
+        /// @brief Returns the value of a keyword as a string, with quotes and trailing spaces removed.
+        ///
+        /// @throws std::runtime_error If the keyword is not present.
+        ///
+        const std::string& get(const std::string& keyword) const
+        {
+            auto it = _keywords.find(keyword);
+            if (it == _keywords.end())
+                throw std::runtime_error("FITS header is missing keyword \"" + keyword + "\"!");
+            return it->second;
+        }
+
+        ///
+        /// @brief Returns the value of a keyword as an integer, or a fallback value if not present.
+        ///
+        std::int64_t get_int(const std::string& keyword, std::int64_t fallback=0) const
+        { return has(keyword) ? std::stoll(get(keyword)) : fallback; }
+
+        ///
+        /// @brief Returns the value of a keyword as a float, or a fallback value if not present.
+        ///
+        double get_double(const std::string& keyword, double fallback=0.0) const
+        {
+            if (!has(keyword))
+                return fallback;
+            // Fortran style double precision exponents
+            std::string value = get(keyword);
+            for (auto& c : value) {
+                if (c == 'D' || c == 'd')
+                    c = 'E';
+            }
+            return std::stod(value);
+        }
+
+        ///
+        /// @brief Returns the extension type (`"IMAGE"`, `"BINTABLE"` or `"TABLE"`), or `"PRIMARY"` for the primary HDU.
+        ///
+        std::string type() const
+        { return has("XTENSION") ? get("XTENSION") : "PRIMARY"; }
+
+        ///
+        /// @brief Returns the BITPIX value: 8, 16, 32 or 64 for integers, or -32 or -64 for floats.
+        ///
+        int bitpix() const
+        { return static_cast<int>(get_int("BITPIX")); }
+
+        ///
+        /// @brief Returns the lengths of the axes, fastest varying axis first.
+        ///
+        std::vector<std::size_t> axes() const
+        {
+            std::vector<std::size_t> result(static_cast<std::size_t>(get_int("NAXIS")));
+            for (std::size_t i=0; i<result.size(); i++)
+                result[i] = static_cast<std::size_t>(get_int("NAXIS" + std::to_string(i + 1)));
+            return result;
+        }
+
+        ///
+        /// @brief Returns a pointer to the raw big endian data.
+        ///
+        const std::uint8_t* data() const
+        { return _data; }
+
+        ///
+        /// @brief Returns the size of the raw data in bytes, without block padding.
+        ///
+        std::size_t data_size() const
+        { return _data_size; }
+    };
+
+
+    ///
+    /// @brief Reader of FITS files.
+    ///
+    /// The file is memory mapped and all HDUs are indexed when opening. Images and numeric binary table columns are
+    /// decoded with the physical value scaling (`BZERO + BSCALE * raw`) applied in the same pass.
+    ///
+    class FitsReader
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        MappedFile _file;
+        std::vector<FitsHdu> _hdus;
+
+
+        // :: CONSTRUCTORS :: //
+        public:
+
+        ///
+        /// @brief Opens a FITS file by memory mapping it.
+        ///
+        /// @param path Path of the file to open.
+        /// @throws std::runtime_error If the file can't be mapped or is malformed.
+        ///
+        explicit FitsReader(const std::string& path)
+            : _file(path)
+        { _parse(); }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns all header data units, the primary HDU first.
+        ///
+        const std::vector<FitsHdu>& hdus() const
+        { return _hdus; }
+
+        ///
+        /// @brief Decodes the pixels of an image HDU into physical values.
+        ///
+        /// Integer pixels equal to `BLANK` become NaN when decoding into a float type. Images of which the scaling only
+        /// represents unsigned integers (e.g. `BITPIX = 16`, `BZERO = 32768`) are decoded exactly into integer types.
+        ///
+        /// @tparam T Type to decode into.
+        /// @param index Index of the HDU.
+        /// @param out Vector receiving the pixels, fastest varying axis first. Resized to the amount of pixels.
+        ///
+        template <typename T>
+        void read_image(std::size_t index, std::vector<T>& out) const
+        {
+            const FitsHdu& hdu = _hdus.at(index);
+            const int bitpix = hdu.bitpix();
+            out.resize(hdu.data_size() / (std::abs(bitpix) / 8));
+            _decode(bitpix, hdu.data(), out.size(), static_cast<std::size_t>(std::abs(bitpix) / 8),
+                    hdu.get_double("BSCALE", 1.0), hdu.get_double("BZERO", 0.0),
+                    hdu.has("BLANK"), hdu.get_int("BLANK"), out.data());
+        }
+
+        ///
+        /// @brief Decodes a numeric column of a binary table HDU into physical values.
+        ///
+        /// Supported column formats are `L`, `B`, `I`, `J`, `K`, `E` and `D`. Logical values decode to 1 if true and 0
+        /// otherwise. Columns with a repeat count greater than one are flattened row by row.
+        ///
+        /// @tparam T Type to decode into.
+        /// @param index Index of the HDU.
+        /// @param column Name of the column (`TTYPEn`).
+        /// @param out Vector receiving the values. Resized to the amount of rows times the repeat count.
+        ///
+        template <typename T>
+        void read_column(std::size_t index, const std::string& column, std::vector<T>& out) const
+        {
+            const FitsHdu& hdu = _hdus.at(index);
+            if (hdu.type() != "BINTABLE")
+                throw std::runtime_error("FITS HDU is not a binary table!");
+
+            const std::size_t row_size = static_cast<std::size_t>(hdu.get_int("NAXIS1"));
+            const std::size_t n_rows = static_cast<std::size_t>(hdu.get_int("NAXIS2"));
+            const std::size_t n_fields = static_cast<std::size_t>(hdu.get_int("TFIELDS"));
+            if (__fits_multiply(n_rows, row_size) > hdu.data_size())
+                throw std::runtime_error("FITS table rows exceed the data of the HDU!");
+
+            std::size_t offset = 0;
+            for (std::size_t n=1; n<=n_fields; n++)
+            {
+                const std::string form = hdu.get("TFORM" + std::to_string(n));
+                std::size_t n_digits = form.find_first_not_of("0123456789");
+                if (n_digits == std::string::npos)
+                    throw std::runtime_error("FITS table has a malformed TFORM" + std::to_string(n) + "!");
+                const std::size_t repeat = n_digits ? std::stoull(form.substr(0, n_digits)) : 1;
+                const char code = form[n_digits];
+                const int bitpix = _bitpix_of_form(code);
+
+                // The fields before and including this one must fit in a row
+                const std::size_t field_size = _size_of_form(code);
+                if (field_size != 0 && repeat > (row_size - offset) / field_size)
+                    throw std::runtime_error("FITS table columns exceed the row size!");
+
+                const std::string name = "TTYPE" + std::to_string(n);
+                if (hdu.has(name) && hdu.get(name) == column)
+                {
+                    // Logical values are stored as the characters 'T' and 'F', or 0 if undefined
+                    if (code == 'L') {
+                        out.resize(n_rows * repeat);
+                        for (std::size_t i=0; i<n_rows; i++) {
+                            for (std::size_t r=0; r<repeat; r++)
+                                out[i * repeat + r] = static_cast<T>(hdu.data()[offset + i * row_size + r] == 'T');
+                        }
+                        return;
+                    }
+                    if (bitpix == 0)
+                        throw std::runtime_error("FITS table column \"" + column + "\" is not numeric!");
+                    const std::size_t width = static_cast<std::size_t>(std::abs(bitpix) / 8);
+                    const std::string suffix = std::to_string(n);
+
+                    out.resize(n_rows * repeat);
+                    for (std::size_t r=0; r<repeat; r++) {
+                        // Element r of every row, written with a stride of the repeat count
+                        std::vector<T> values(n_rows);
+                        _decode(bitpix, hdu.data() + offset + r * width, n_rows, row_size,
+                                hdu.get_double("TSCAL" + suffix, 1.0), hdu.get_double("TZERO" + suffix, 0.0),
+                                hdu.has("TNULL" + suffix), hdu.get_int("TNULL" + suffix), values.data());
+                        for (std::size_t i=0; i<n_rows; i++)
+                            out[i * repeat + r] = values[i];
+                    }
+                    return;
+                }
+
+                offset += repeat * field_size;
+            }
+            throw std::runtime_error("FITS table has no column \"" + column + "\"!");
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        // Returns the equivalent BITPIX of a binary table column format, or 0 if not numeric
+        static int _bitpix_of_form(char code)
+        {
+            switch (code) {
+                case 'L': case 'B': return 8;
+                case 'I': return 16;
+                case 'J': return 32;
+                case 'K': return 64;
+                case 'E': return -32;
+                case 'D': return -64;
+                default:  return 0;
+            }
+        }
+
+        static std::size_t _size_of_form(char code)
+        {
+            switch (code) {
+                case 'A': return 1;
+                case 'C': return 8;
+                case 'M': return 16;
+                case 'P': return 8;
+                case 'Q': return 16;
+                case 'X': throw std::runtime_error("FITS table bit columns are not supported!");
+                default:  return static_cast<std::size_t>(std::abs(_bitpix_of_form(code)) / 8);
+            }
+        }
+
+        template <typename IO_T, typename T>
+        static void _decode_scaled(const std::uint8_t* bytes, std::size_t count, std::size_t stride,
+                                   double bscale, double bzero, bool has_blank, std::int64_t blank, T* out)
+        {
+            using RAW_T = typename IO_T::value_type;
+            constexpr bool IS_FLOAT_DATA = std::is_floating_point_v<RAW_T>;
+
+            if constexpr (!IS_FLOAT_DATA)
+            {
+                if constexpr (std::is_integral_v<T>) {
+                    // Offsetting signed data by half the range gives unsigned values (and unsigned BITPIX 8 data by
+                    // minus half the range gives signed values), which is the same as flipping the sign bit
+                    using URAW_T = std::make_unsigned_t<RAW_T>;
+                    using PHYSICAL_T = std::conditional_t<std::is_signed_v<RAW_T>, URAW_T, std::make_signed_t<RAW_T>>;
+                    constexpr URAW_T SIGN_BIT = static_cast<URAW_T>(static_cast<URAW_T>(1) << (sizeof(RAW_T) * 8 - 1));
+                    const double offset = std::ldexp(std::is_signed_v<RAW_T> ? 1.0 : -1.0, static_cast<int>(sizeof(RAW_T)) * 8 - 1);
+                    if (bscale == 1.0 && bzero == offset) {
+                        for (std::size_t i=0; i<count; i++) {
+                            URAW_T raw = static_cast<URAW_T>(IO_T::template unpack<Endian::BIG>(bytes + i * stride));
+                            out[i] = static_cast<T>(static_cast<PHYSICAL_T>(raw ^ SIGN_BIT));
+                        }
+                        return;
+                    }
+                }
+                if constexpr (std::is_floating_point_v<T>) {
+                    if (has_blank) {
+                        const RAW_T blank_raw = static_cast<RAW_T>(blank);
+                        for (std::size_t i=0; i<count; i++) {
+                            RAW_T raw = IO_T::template unpack<Endian::BIG>(bytes + i * stride);
+                            T value = static_cast<T>(bzero + bscale * static_cast<double>(raw));
+                            out[i] = raw == blank_raw ? std::numeric_limits<T>::quiet_NaN() : value;
+                        }
+                        return;
+                    }
+                }
+            }
+
+            if (bscale == 1.0 && bzero == 0.0) {
+                for (std::size_t i=0; i<count; i++)
+                    out[i] = static_cast<T>(IO_T::template unpack<Endian::BIG>(bytes + i * stride));
+                return;
+            }
+
+            // Compute in double precision like the blank path above, so that values don't depend on BLANK being set
+            for (std::size_t i=0; i<count; i++)
+                out[i] = static_cast<T>(bzero + bscale * static_cast<double>(IO_T::template unpack<Endian::BIG>(bytes + i * stride)));
+        }
+
+        template <typename T>
+        static void _decode(int bitpix, const std::uint8_t* bytes, std::size_t count, std::size_t stride,
+                            double bscale, double bzero, bool has_blank, std::int64_t blank, T* out)
+        {
+            switch (bitpix) {
+                case   8: _decode_scaled< u8_IO>(bytes, count, stride, bscale, bzero, has_blank, blank, out); break;
+                case  16: _decode_scaled<i16_IO>(bytes, count, stride, bscale, bzero, has_blank, blank, out); break;
+                case  32: _decode_scaled<i32_IO>(bytes, count, stride, bscale, bzero, has_blank, blank, out); break;
+                case  64: _decode_scaled<i64_IO>(bytes, count, stride, bscale, bzero, has_blank, blank, out); break;
+                case -32: _decode_scaled<fp32_IO>(bytes, count, stride, bscale, bzero, has_blank, blank, out); break;
+                case -64: _decode_scaled<fp64_IO>(bytes, count, stride, bscale, bzero, has_blank, blank, out); break;
+                default: throw std::runtime_error("FITS data has an unsupported BITPIX of " + std::to_string(bitpix) + "!");
+            }
+        }
+
+        void _parse()
+        {
+            const std::uint8_t* bytes = _file.data();
+            const std::size_t size = _file.size();
+            std::size_t offset = 0;
+
+            while (offset + __FITS_BLOCK_SIZE <= size)
+            {
+                FitsHdu hdu;
+                bool has_end = false;
+
+                // Header of 80 character cards, padded to whole blocks
+                while (!has_end)
+                {
+                    if (offset + __FITS_BLOCK_SIZE > size)
+                        throw std::runtime_error("FITS header is truncated!");
+                    for (std::size_t card=0; card<__FITS_BLOCK_SIZE && !has_end; card+=__FITS_CARD_SIZE)
+                    {
+                        const std::string line(reinterpret_cast<const char*>(bytes + offset + card), __FITS_CARD_SIZE);
+                        const std::string keyword = __fits_trim(line.substr(0, 8));
+                        if (keyword == "END")
+                            has_end = true;
+                        else if (line.compare(8, 2, "= ") == 0 && !hdu.has(keyword))
+                            hdu._keywords[keyword] = _parse_value(line.substr(10));
+                    }
+                    offset += __FITS_BLOCK_SIZE;
+                }
+
+                if (_hdus.empty() ? !hdu.has("SIMPLE") : !hdu.has("XTENSION"))
+                    throw std::runtime_error("FITS file is malformed!");
+
+                // Size = |BITPIX| / 8 * GCOUNT * (PCOUNT + NAXIS1 * ... * NAXISn)
+                const std::int64_t n_axes = hdu.get_int("NAXIS");
+                if (n_axes < 0 || n_axes > 999)
+                    throw std::runtime_error("FITS file is malformed!");
+                std::size_t n_elements = 0;
+                if (n_axes > 0) {
+                    n_elements = 1;
+                    for (auto axis : hdu.axes())
+                        n_elements = __fits_multiply(n_elements, axis);
+                }
+                const std::size_t pcount = static_cast<std::size_t>(hdu.get_int("PCOUNT"));
+                if (pcount > std::numeric_limits<std::size_t>::max() - n_elements)
+                    throw std::runtime_error("FITS data size is too large!");
+                n_elements = __fits_multiply(pcount + n_elements, static_cast<std::size_t>(hdu.get_int("GCOUNT", 1)));
+                hdu._data_size = __fits_multiply(n_elements, static_cast<std::size_t>(std::abs(hdu.bitpix()) / 8));
+                if (hdu._data_size > size - offset)
+                    throw std::runtime_error("FITS data is truncated!");
+                hdu._data = bytes + offset;
+
+                offset += (hdu._data_size + __FITS_BLOCK_SIZE - 1) / __FITS_BLOCK_SIZE * __FITS_BLOCK_SIZE;
+                _hdus.push_back(std::move(hdu));
+            }
+
+            if (_hdus.empty())
+                throw std::runtime_error("Data is not a FITS file!");
+        }
+
+        static std::string _parse_value(const std::string& field)
+        {
+            std::string value = __fits_trim(field);
+            if (!value.empty() && value[0] == '\'')
+            {
+                // Quoted string, where two quotes escape a single quote
+                std::string result;
+                for (std::size_t i=1; i<value.size(); i++) {
+                    if (value[i] == '\'') {
+                        if (i + 1 < value.size() && value[i+1] == '\'')
+                            i++;
+                        else
+                            break;
+                    }
+                    result += value[i];
+                }
+                return __fits_trim(result);
+            }
+            return __fits_trim(value.substr(0, value.find('/')));
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_FITS_H */
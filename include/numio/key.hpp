@@ -0,0 +1,400 @@
+#ifndef NUMIO_KEY_H
+#define NUMIO_KEY_H
+
+// ****************************************************************************
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../numio.hpp"
+#include "std.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    ///
+    /// @brief Template class for order-preserving integer keys.
+    ///
+    /// Values are packed big endian in exactly the amount of bytes needed for `N_BITS`, with the sign bit of signed
+    /// values flipped, so that comparing packed keys with `memcmp` gives the same order as comparing the values.
+    ///
+    /// @tparam INT_T Integer type to (un)pack.
+    /// @tparam N_BITS Amount of bits of the packed integer value.
+    ///
+    template <typename INT_T, unsigned int N_BITS=sizeof(INT_T)*8>
+    class KeyIntIO
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        using _UINT_T = std::make_unsigned_t<INT_T>;
+        using _INTIO_TYPE = IntIO<_UINT_T, N_BITS, false>;
+
+        static constexpr _UINT_T _SIGN_BIT = std::is_signed_v<INT_T>
+            ? static_cast<_UINT_T>(static_cast<_UINT_T>(1) << (N_BITS - 1))
+            : 0;
+        static constexpr _UINT_T _VALUE_MASK = N_BITS == sizeof(_UINT_T) * 8
+            ? static_cast<_UINT_T>(~static_cast<_UINT_T>(0))
+            : static_cast<_UINT_T>((static_cast<_UINT_T>(1) << (N_BITS % (sizeof(_UINT_T) * 8))) - 1);
+
+
+        // :: PUBLIC ATTRIBUTES :: //
+        public:
+
+        ///
+        /// @brief The amount of bytes used for the packed key.
+        ///
+        static constexpr int N_IO_BYTES = _INTIO_TYPE::N_IO_BYTES;
+
+        ///
+        /// @brief Integer container type.
+        ///
+        using value_type = INT_T;
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Packs a value as a key.
+        ///
+        /// @param value Value to pack.
+        /// @param bytes Pointer to write exactly `N_IO_BYTES` bytes to.
+        ///
+        static void pack(INT_T value, std::uint8_t* bytes)
+        { _INTIO_TYPE::template pack<Endian::BIG>(static_cast<_UINT_T>((static_cast<_UINT_T>(value) ^ _SIGN_BIT) & _VALUE_MASK), bytes); }
+
+        ///
+        /// @brief Unpacks a value from a key.
+        ///
+        /// @param bytes Pointer to the first byte of the key.
+        ///
+        static INT_T unpack(const std::uint8_t* bytes)
+        {
+            _UINT_T value = _INTIO_TYPE::template unpack<Endian::BIG>(bytes) ^ _SIGN_BIT;
+            // Sign extension
+            if constexpr (std::is_signed_v<INT_T> && N_BITS < sizeof(_UINT_T) * 8) {
+                if (value & _SIGN_BIT)
+                    value |= static_cast<_UINT_T>(~_VALUE_MASK);
+            }
+            return static_cast<INT_T>(value);
+        }
+
+        ///
+        /// @brief Packs multiple values as consecutive keys.
+        ///
+        /// @param values Pointer to the first value.
+        /// @param count Amount of values.
+        /// @param bytes Pointer to write `count * N_IO_BYTES` bytes to.
+        ///
+        static void pack(const INT_T* values, std::size_t count, std::uint8_t* bytes)
+        {
+            for (std::size_t i=0; i<count; i++)
+                pack(values[i], bytes + i * N_IO_BYTES);
+        }
+
+        ///
+        /// @brief Unpacks multiple consecutive keys.
+        ///
+        /// @param bytes Pointer to the first byte of the first key.
+        /// @param count Amount of keys.
+        /// @param out Pointer to write `count` values to.
+        ///
+        static void unpack(const std::uint8_t* bytes, std::size_t count, INT_T* out)
+        {
+            for (std::size_t i=0; i<count; i++)
+                out[i] = unpack(bytes + i * N_IO_BYTES);
+        }
+    };
+
+
+    ///
+    /// @brief Template class for order-preserving float keys.
+    ///
+    /// The binary representation of a float format is packed big endian with all bits inverted for negative values
+    /// and only the sign bit flipped otherwise, so that comparing packed keys with `memcmp` gives the numeric order.
+    /// Negative zero sorts just before positive zero, and NaNs sort beyond the infinity of their sign.
+    ///
+    /// @tparam FLOAT_IO_T `FloatIO` type describing the float format, e.g. `NumIO::fp32_IO`.
+    ///
+    template <typename FLOAT_IO_T>
+    class KeyFloatIO
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        using _FLOAT_T = typename FLOAT_IO_T::value_type;
+        using _BITS_IO_TYPE = typename FLOAT_IO_T::int_io_type;
+        using _UINT_T = std::make_unsigned_t<typename _BITS_IO_TYPE::value_type>;
+        using _INTIO_TYPE = IntIO<_UINT_T, _BITS_IO_TYPE::N_VALUE_BITS, false>;
+
+        static constexpr unsigned int _N_BITS = _BITS_IO_TYPE::N_VALUE_BITS;
+        static constexpr _UINT_T _SIGN_BIT = static_cast<_UINT_T>(static_cast<_UINT_T>(1) << (_N_BITS - 1));
+        static constexpr _UINT_T _VALUE_MASK = _N_BITS == sizeof(_UINT_T) * 8
+            ? static_cast<_UINT_T>(~static_cast<_UINT_T>(0))
+            : static_cast<_UINT_T>((static_cast<_UINT_T>(1) << (_N_BITS % (sizeof(_UINT_T) * 8))) - 1);
+
+
+        // :: PUBLIC ATTRIBUTES :: //
+        public:
+
+        ///
+        /// @brief The amount of bytes used for the packed key.
+        ///
+        static constexpr int N_IO_BYTES = _INTIO_TYPE::N_IO_BYTES;
+
+        ///
+        /// @brief Float container type.
+        ///
+        using value_type = _FLOAT_T;
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Packs a value as a key.
+        ///
+        /// @param value Value to pack.
+        /// @param bytes Pointer to write exactly `N_IO_BYTES` bytes to.
+        /// @throws std::runtime_error If the value is out of range of the float format.
+        ///
+        static void pack(_FLOAT_T value, std::uint8_t* bytes)
+        {
+            _UINT_T bits = static_cast<_UINT_T>(FLOAT_IO_T::encode(value)) & _VALUE_MASK;
+            bits = bits & _SIGN_BIT ? static_cast<_UINT_T>(~bits & _VALUE_MASK) : static_cast<_UINT_T>(bits | _SIGN_BIT);
+            _INTIO_TYPE::template pack<Endian::BIG>(bits, bytes);
+        }
+
+        ///
+        /// @brief Unpacks a value from a key.
+        ///
+        /// @param bytes Pointer to the first byte of the key.
+        ///
+        static _FLOAT_T unpack(const std::uint8_t* bytes)
+        {
+            _UINT_T bits = _INTIO_TYPE::template unpack<Endian::BIG>(bytes);
+            bits = bits & _SIGN_BIT ? static_cast<_UINT_T>(bits & ~_SIGN_BIT) : static_cast<_UINT_T>(~bits & _VALUE_MASK);
+            return FLOAT_IO_T::decode(static_cast<typename _BITS_IO_TYPE::value_type>(bits));
+        }
+
+        ///
+        /// @brief Packs multiple values as consecutive keys.
+        ///
+        /// @param values Pointer to the first value.
+        /// @param count Amount of values.
+        /// @param bytes Pointer to write `count * N_IO_BYTES` bytes to.
+        ///
+        static void pack(const _FLOAT_T* values, std::size_t count, std::uint8_t* bytes)
+        {
+            for (std::size_t i=0; i<count; i++)
+                pack(values[i], bytes + i * N_IO_BYTES);
+        }
+
+        ///
+        /// @brief Unpacks multiple consecutive keys.
+        ///
+        /// @param bytes Pointer to the first byte of the first key.
+        /// @param count Amount of keys.
+        /// @param out Pointer to write `count` values to.
+        ///
+        static void unpack(const std::uint8_t* bytes, std::size_t count, _FLOAT_T* out)
+        {
+            for (std::size_t i=0; i<count; i++)
+                out[i] = unpack(bytes + i * N_IO_BYTES);
+        }
+    };
+
+
+    using  i8_key_IO = KeyIntIO<std:: int8_t>;
+    using i16_key_IO = KeyIntIO<std::int16_t>;
+    using i24_key_IO = KeyIntIO<std::int32_t, 24>;
+    using i32_key_IO = KeyIntIO<std::int32_t>;
+    using i40_key_IO = KeyIntIO<std::int64_t, 40>;
+    using i48_key_IO = KeyIntIO<std::int64_t, 48>;
+    using i56_key_IO = KeyIntIO<std::int64_t, 56>;
+    using i64_key_IO = KeyIntIO<std::int64_t>;
+
+    using  u8_key_IO = KeyIntIO<std:: uint8_t>;
+    using u16_key_IO = KeyIntIO<std::uint16_t>;
+    using u24_key_IO = KeyIntIO<std::uint32_t, 24>;
+    using u32_key_IO = KeyIntIO<std::uint32_t>;
+    using u40_key_IO = KeyIntIO<std::uint64_t, 40>;
+    using u48_key_IO = KeyIntIO<std::uint64_t, 48>;
+    using u56_key_IO = KeyIntIO<std::uint64_t, 56>;
+    using u64_key_IO = KeyIntIO<std::uint64_t>;
+
+    using fp16_key_IO = KeyFloatIO<fp16_IO>;
+    using fp32_key_IO = KeyFloatIO<fp32_IO>;
+    using fp64_key_IO = KeyFloatIO<fp64_IO>;
+
+
+    ///
+    /// @brief Builder of composite keys, of which the byte order (`memcmp`) follows the order of the fields from first
+    /// to last.
+    ///
+    class KeyBuilder
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        std::vector<std::uint8_t> _bytes;
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Appends a numeric field.
+        ///
+        /// @tparam KEY_IO_T Key IO type of the field, e.g. `NumIO::i24_key_IO`.
+        /// @param value Value of the field.
+        /// @param is_descending Inverts the bytes of the field so that it sorts in descending order.
+        ///
+        template <typename KEY_IO_T>
+        KeyBuilder& add(typename KEY_IO_T::value_type value, bool is_descending=false)
+        {
+            const std::size_t offset = _bytes.size();
+            _bytes.resize(offset + KEY_IO_T::N_IO_BYTES);
+            KEY_IO_T::pack(value, _bytes.data() + offset);
+            if (is_descending) {
+                for (std::size_t i=offset; i<_bytes.size(); i++)
+                    _bytes[i] = static_cast<std::uint8_t>(~_bytes[i]);
+            }
+            return *this;
+        }
+
+        ///
+        /// @brief Appends a variable length byte string field.
+        ///
+        /// Null bytes are escaped as `00 FF` and the field is terminated by `00 00`, so that a string sorts before
+        /// any longer string it is a prefix of, regardless of the fields that follow.
+        ///
+        KeyBuilder& add_string(const std::string& value)
+        {
+            _bytes.reserve(_bytes.size() + value.size() + 2);
+            for (char c : value) {
+                _bytes.push_back(static_cast<std::uint8_t>(c));
+                if (c == '\0')
+                    _bytes.push_back(0xFF);
+            }
+            _bytes.push_back(0x00);
+            _bytes.push_back(0x00);
+            return *this;
+        }
+
+        ///
+        /// @brief Removes all fields.
+        ///
+        void clear()
+        { _bytes.clear(); }
+
+        ///
+        /// @brief Returns a pointer to the first byte of the key.
+        ///
+        const std::uint8_t* data() const
+        { return _bytes.data(); }
+
+        ///
+        /// @brief Returns the size of the key in bytes.
+        ///
+        std::size_t size() const
+        { return _bytes.size(); }
+
+        ///
+        /// @brief Returns the bytes of the key.
+        ///
+        const std::vector<std::uint8_t>& bytes() const
+        { return _bytes; }
+    };
+
+
+    ///
+    /// @brief Reader of the fields of a composite key built by `KeyBuilder`, in the same order.
+    ///
+    class KeyParser
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        const std::uint8_t* _data;
+        std::size_t _size;
+        std::size_t _position;
+
+
+        // :: CONSTRUCTORS :: //
+        public:
+
+        ///
+        /// @brief Constructs a parser over a key.
+        ///
+        /// @param data Pointer to the first byte of the key.
+        /// @param size Size of the key in bytes.
+        ///
+        KeyParser(const std::uint8_t* data, std::size_t size)
+            : _data(data), _size(size), _position(0)
+        {}
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Reads a numeric field.
+        ///
+        /// @tparam KEY_IO_T Key IO type of the field.
+        /// @param is_descending Must match the value used when building the key.
+        /// @throws std::runtime_error If the key is too short.
+        ///
+        template <typename KEY_IO_T>
+        typename KEY_IO_T::value_type next(bool is_descending=false)
+        {
+            if (_size - _position < static_cast<std::size_t>(KEY_IO_T::N_IO_BYTES))
+                throw std::runtime_error("Key is too short for the requested field!");
+            std::uint8_t bytes[KEY_IO_T::N_IO_BYTES];
+            for (int i=0; i<KEY_IO_T::N_IO_BYTES; i++)
+                bytes[i] = is_descending ? static_cast<std::uint8_t>(~_data[_position + i]) : _data[_position + i];
+            _position += KEY_IO_T::N_IO_BYTES;
+            return KEY_IO_T::unpack(bytes);
+        }
+
+        ///
+        /// @brief Reads a byte string field.
+        ///
+        /// @throws std::runtime_error If the field is not terminated.
+        ///
+        std::string next_string()
+        {
+            std::string result;
+            while (_position + 1 < _size)
+            {
+                const std::uint8_t c = _data[_position++];
+                if (c != 0x00) {
+                    result += static_cast<char>(c);
+                    continue;
+                }
+                const std::uint8_t escape = _data[_position++];
+                if (escape == 0x00)
+                    return result;
+                if (escape != 0xFF)
+                    throw std::runtime_error("Key string field has an invalid escape sequence!");
+                result += '\0';
+            }
+            throw std::runtime_error("Key string field is not terminated!");
+        }
+
+        ///
+        /// @brief Returns the amount of bytes not yet read.
+        ///
+        std::size_t remaining() const
+        { return _size - _position; }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_KEY_H */
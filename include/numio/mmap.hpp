@@ -0,0 +1,177 @@
+#ifndef NUMIO_MMAP_H
+#define NUMIO_MMAP_H
+
+// ****************************************************************************
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+        #define NUMIO_UNDEFINE_WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+        #define NUMIO_UNDEFINE_NOMINMAX
+    #endif
+    #include <windows.h>
+    #ifdef NUMIO_UNDEFINE_WIN32_LEAN_AND_MEAN
+        #undef WIN32_LEAN_AND_MEAN
+        #undef NUMIO_UNDEFINE_WIN32_LEAN_AND_MEAN
+    #endif
+    #ifdef NUMIO_UNDEFINE_NOMINMAX
+        #undef NOMINMAX
+        #undef NUMIO_UNDEFINE_NOMINMAX
+    #endif
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    ///
+    /// @brief Read-only memory mapping of a whole file.
+    ///
+    /// The mapping is released when the object is destroyed. Empty files are not mapped and have a null `data()`.
+    ///
+    class MappedFile
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        const std::uint8_t* _data = nullptr;
+        std::size_t _size = 0;
+
+
+        // :: CONSTRUCTORS & DESTRUCTOR :: //
+        public:
+
+        ///
+        /// @brief Constructs an empty mapping.
+        ///
+        MappedFile() = default;
+
+        ///
+        /// @brief Maps a file into memory.
+        ///
+        /// @param path Path of the file to map.
+        /// @throws std::runtime_error If the file can't be opened or mapped.
+        ///
+        explicit MappedFile(const std::string& path)
+        {
+            #if defined(_WIN32)
+                HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (file == INVALID_HANDLE_VALUE)
+                    throw std::runtime_error("Could not open file \"" + path + "\"!");
+
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(file, &size)) {
+                    CloseHandle(file);
+                    throw std::runtime_error("Could not determine the size of file \"" + path + "\"!");
+                }
+                _size = static_cast<std::size_t>(size.QuadPart);
+
+                if (_size)
+                {
+                    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (mapping) {
+                        _data = static_cast<const std::uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                        CloseHandle(mapping);
+                    }
+                }
+                CloseHandle(file);
+            #else
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                    throw std::runtime_error("Could not open file \"" + path + "\"!");
+
+                struct stat info;
+                if (::fstat(fd, &info) != 0) {
+                    ::close(fd);
+                    throw std::runtime_error("Could not determine the size of file \"" + path + "\"!");
+                }
+                _size = static_cast<std::size_t>(info.st_size);
+
+                if (_size)
+                {
+                    void* address = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (address != MAP_FAILED)
+                        _data = static_cast<const std::uint8_t*>(address);
+                }
+                ::close(fd);
+            #endif
+
+            if (_size && !_data) {
+                _size = 0;
+                throw std::runtime_error("Could not memory map file \"" + path + "\"!");
+            }
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
+            : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0))
+        {}
+
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (this != &other) {
+                _unmap();
+                _data = std::exchange(other._data, nullptr);
+                _size = std::exchange(other._size, 0);
+            }
+            return *this;
+        }
+
+        ~MappedFile()
+        { _unmap(); }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns a pointer to the first byte of the mapped file.
+        ///
+        const std::uint8_t* data() const
+        { return _data; }
+
+        ///
+        /// @brief Returns the size of the mapped file in bytes.
+        ///
+        std::size_t size() const
+        { return _size; }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        void _unmap()
+        {
+            if (!_data)
+                return;
+            #if defined(_WIN32)
+                UnmapViewOfFile(_data);
+            #else
+                ::munmap(const_cast<std::uint8_t*>(_data), _size);
+            #endif
+            _data = nullptr;
+            _size = 0;
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_MMAP_H */
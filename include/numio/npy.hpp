@@ -0,0 +1,484 @@
+#ifndef NUMIO_NPY_H
+#define NUMIO_NPY_H
+
+// ****************************************************************************
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../numio.hpp"
+#include "mmap.hpp"
+#include "pool.hpp"
+#include "std.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    ///
+    /// @brief Element type of a NumPy array, as described by the `descr` field of a `.npy` header.
+    ///
+    struct NpyDtype
+    {
+        /// Kind of the elements: `'b'` for bool, `'i'` for signed integers, `'u'` for unsigned integers and `'f'` for
+        /// IEEE 754 floats.
+        char kind = 'f';
+        /// Size of an element in bytes.
+        unsigned int size = 8;
+        /// Byte order of the elements. Single byte elements are always reported as `Endian::NATIVE`.
+        Endian endianness = Endian::LITTLE;
+
+        ///
+        /// @brief Returns the dtype describing a C++ type in a given byte order.
+        ///
+        /// @tparam T Element type. Either `bool`, an integer type, `float` or `double`.
+        /// @param endianness Byte order of the elements.
+        ///
+        template <typename T>
+        static NpyDtype of(Endian endianness=Endian::NATIVE)
+        {
+            static_assert(std::is_arithmetic_v<T>, "Template parameter T must be an arithmetic type!");
+            static_assert(!std::is_floating_point_v<T> || sizeof(T) == 4 || sizeof(T) == 8,
+                          "Only float and double are supported float types!");
+            NpyDtype dtype;
+            dtype.kind = std::is_same_v<T, bool>     ? 'b'
+                       : std::is_floating_point_v<T> ? 'f'
+                       : std::is_signed_v<T>         ? 'i'
+                       :                               'u';
+            dtype.size = sizeof(T);
+            dtype.endianness = sizeof(T) == 1 ? Endian::NATIVE : endianness;
+            return dtype;
+        }
+
+        ///
+        /// @brief Returns the `descr` string, e.g. `"<f4"`.
+        ///
+        std::string descr() const
+        {
+            char order = size == 1 ? '|' : endianness == Endian::BIG ? '>' : '<';
+            return std::string(1, order) + kind + std::to_string(size);
+        }
+
+        bool operator==(const NpyDtype& other) const
+        { return kind == other.kind && size == other.size && endianness == other.endianness; }
+
+        bool operator!=(const NpyDtype& other) const
+        { return !(*this == other); }
+    };
+
+    namespace {
+        static constexpr char __NPY_MAGIC[] = "\x93NUMPY";
+        static constexpr std::size_t __NPY_MAGIC_SIZE = 6;
+        static constexpr std::size_t __NPY_ALIGNMENT = 64;
+
+        // Calls `f` with the IO type matching a dtype, as a default constructed tag value
+        template <typename FUNC_T>
+        static void __npy_visit(const NpyDtype& dtype, FUNC_T&& f)
+        {
+            switch (dtype.kind) {
+                case 'i':
+                    switch (dtype.size) {
+                        case 1: return f(i8_IO());
+                        case 2: return f(i16_IO());
+                        case 4: return f(i32_IO());
+                        case 8: return f(i64_IO());
+                    }
+                    break;
+                case 'b':
+                case 'u':
+                    switch (dtype.size) {
+                        case 1: return f(u8_IO());
+                        case 2: return f(u16_IO());
+                        case 4: return f(u32_IO());
+                        case 8: return f(u64_IO());
+                    }
+                    break;
+                case 'f':
+                    switch (dtype.size) {
+                        case 2: return f(fp16_IO());
+                        case 4: return f(fp32_IO());
+                        case 8: return f(fp64_IO());
+                    }
+                    break;
+            }
+            throw std::runtime_error("Unsupported NumPy dtype \"" + dtype.descr() + "\"!");
+        }
+    }
+
+
+    ///
+    /// @brief Reader of NumPy `.npy` files.
+    ///
+    /// The file is memory mapped. Arrays of which the dtype matches the requested C++ type and host byte order can be
+    /// accessed in place through `view()`, all others are converted with `to_vector()`.
+    ///
+    class NpyReader
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        MappedFile _file;
+        NpyDtype _dtype;
+        bool _fortran_order = false;
+        std::vector<std::size_t> _shape;
+        std::size_t _n_elements = 1;
+        std::size_t _data_offset = 0;
+
+
+        // :: CONSTRUCTORS :: //
+        public:
+
+        ///
+        /// @brief Opens a `.npy` file by memory mapping it.
+        ///
+        /// @param path Path of the file to open.
+        /// @throws std::runtime_error If the file can't be mapped, is malformed or has an unsupported dtype.
+        ///
+        explicit NpyReader(const std::string& path)
+            : _file(path)
+        { _parse_header(); }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns the element type of the array.
+        ///
+        const NpyDtype& dtype() const
+        { return _dtype; }
+
+        ///
+        /// @brief Returns the dimensions of the array.
+        ///
+        const std::vector<std::size_t>& shape() const
+        { return _shape; }
+
+        ///
+        /// @brief Returns if the array is stored in column-major (Fortran) order instead of row-major (C) order.
+        ///
+        bool fortran_order() const
+        { return _fortran_order; }
+
+        ///
+        /// @brief Returns the total amount of elements.
+        ///
+        std::size_t size() const
+        { return _n_elements; }
+
+        ///
+        /// @brief Returns a pointer to the raw element data.
+        ///
+        const std::uint8_t* data() const
+        { return _file.data() + _data_offset; }
+
+        ///
+        /// @brief Checks if the array can be accessed in place as elements of type `T`.
+        ///
+        template <typename T>
+        bool is_viewable() const
+        {
+            return _dtype == NpyDtype::of<T>()
+                && reinterpret_cast<std::uintptr_t>(data()) % alignof(T) == 0;
+        }
+
+        ///
+        /// @brief Returns the elements in place, without copying or converting.
+        ///
+        /// @tparam T Element type. Must match the dtype of the array in host byte order.
+        /// @return Pointer to `size()` elements, valid for the lifetime of the reader.
+        /// @throws std::runtime_error If the array can't be viewed as `T`.
+        ///
+        template <typename T>
+        const T* view() const
+        {
+            if (!is_viewable<T>())
+                throw std::runtime_error("NumPy array of dtype \"" + _dtype.descr() + "\" can't be viewed as the requested type!");
+            return reinterpret_cast<const T*>(data());
+        }
+
+        ///
+        /// @brief Converts the elements to a C++ type, in a single pass over the data.
+        ///
+        /// @tparam T Element type to convert to.
+        /// @param out Vector receiving the elements. Resized to `size()`.
+        ///
+        template <typename T>
+        void to_vector(std::vector<T>& out) const
+        {
+            out.resize(_n_elements);
+            const std::uint8_t* bytes = data();
+            const std::size_t n = _n_elements;
+            const bool is_big = _dtype.endianness == Endian::BIG;
+
+            // std::vector<bool> is packed into bits, so it has no contiguous storage to copy or convert into
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                __npy_visit(_dtype, [&](auto io)
+                {
+                    using IO_T = decltype(io);
+                    for (std::size_t i=0; i<n; i++)
+                        out[i] = (is_big ? IO_T::template unpack<Endian::BIG>(bytes + i * IO_T::N_IO_BYTES)
+                                         : IO_T::template unpack<Endian::LITTLE>(bytes + i * IO_T::N_IO_BYTES)) != 0;
+                });
+            }
+            else
+            {
+                if (is_viewable<T>()) {
+                    std::memcpy(out.data(), bytes, n * sizeof(T));
+                    return;
+                }
+
+                T* dst = out.data();
+                __npy_visit(_dtype, [&](auto io)
+                {
+                    using IO_T = decltype(io);
+                    if (is_big)
+                        _convert<IO_T, Endian::BIG>(bytes, n, dst);
+                    else
+                        _convert<IO_T, Endian::LITTLE>(bytes, n, dst);
+                });
+            }
+        }
+
+        ///
+        /// @brief Converts the elements to a C++ type, in a single pass over the data.
+        ///
+        /// @tparam T Element type to convert to.
+        /// @return Vector holding `size()` elements.
+        ///
+        template <typename T>
+        std::vector<T> to_vector() const
+        {
+            std::vector<T> out;
+            to_vector(out);
+            return out;
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        template <typename IO_T, Endian ENDIANNESS_V, typename T>
+        static void _convert(const std::uint8_t* bytes, std::size_t count, T* out)
+        {
+            for (std::size_t i=0; i<count; i++)
+                out[i] = static_cast<T>(IO_T::template unpack<ENDIANNESS_V>(bytes + i * IO_T::N_IO_BYTES));
+        }
+
+        // Parses a number of the header, as std::stoull would throw a std::logic_error on malformed ones
+        static std::size_t _parse_number(const std::string& digits)
+        {
+            if (digits.empty() || digits.size() > std::numeric_limits<std::size_t>::digits10
+                || digits.find_first_not_of("0123456789") != std::string::npos)
+                throw std::runtime_error("NumPy header has an invalid number \"" + digits + "\"!");
+            return static_cast<std::size_t>(std::stoull(digits));
+        }
+
+        // Returns the position right after the value of a key in the header dictionary
+        static std::size_t _find_value(const std::string& header, const char* key)
+        {
+            std::size_t pos = header.find(std::string("'") + key + "'");
+            if (pos == std::string::npos)
+                throw std::runtime_error(std::string("NumPy header is missing key \"") + key + "\"!");
+            pos = header.find(':', pos);
+            if (pos == std::string::npos)
+                throw std::runtime_error("NumPy header is malformed!");
+            return header.find_first_not_of(' ', pos + 1);
+        }
+
+        void _parse_header()
+        {
+            const std::uint8_t* bytes = _file.data();
+            const std::size_t size = _file.size();
+            if (size < __NPY_MAGIC_SIZE + 4 || std::memcmp(bytes, __NPY_MAGIC, __NPY_MAGIC_SIZE) != 0)
+                throw std::runtime_error("Data is not a NumPy file!");
+
+            const std::uint8_t major = bytes[__NPY_MAGIC_SIZE];
+            std::size_t header_offset = __NPY_MAGIC_SIZE + 2;
+            std::size_t header_size;
+            if (major == 1) {
+                header_size = u16_IO::unpack<Endian::LITTLE>(bytes + header_offset);
+                header_offset += 2;
+            }
+            else if (major == 2 || major == 3) {
+                if (size < header_offset + 4)
+                    throw std::runtime_error("NumPy file is truncated!");
+                header_size = u32_IO::unpack<Endian::LITTLE>(bytes + header_offset);
+                header_offset += 4;
+            }
+            else {
+                throw std::runtime_error("Unsupported NumPy file format version!");
+            }
+
+            if (size < header_offset + header_size)
+                throw std::runtime_error("NumPy file is truncated!");
+            const std::string header(reinterpret_cast<const char*>(bytes + header_offset), header_size);
+            _data_offset = header_offset + header_size;
+
+            // descr
+            std::size_t pos = _find_value(header, "descr");
+            if (pos == std::string::npos || (header[pos] != '\'' && header[pos] != '"'))
+                throw std::runtime_error("Unsupported NumPy dtype, only simple dtypes are supported!");
+            std::size_t end = header.find(header[pos], pos + 1);
+            const std::string descr = header.substr(pos + 1, end - pos - 1);
+            if (descr.size() < 3)
+                throw std::runtime_error("Unsupported NumPy dtype \"" + descr + "\"!");
+            switch (descr[0]) {
+                case '<': _dtype.endianness = Endian::LITTLE; break;
+                case '>': _dtype.endianness = Endian::BIG;    break;
+                case '|':
+                case '=': _dtype.endianness = Endian::NATIVE; break;
+                default: throw std::runtime_error("Unsupported NumPy dtype \"" + descr + "\"!");
+            }
+            _dtype.kind = descr[1];
+            const std::size_t n_bytes = _parse_number(descr.substr(2));
+            if (n_bytes > 8)
+                throw std::runtime_error("Unsupported NumPy dtype \"" + descr + "\"!");
+            _dtype.size = static_cast<unsigned int>(n_bytes);
+            if (_dtype.size == 1)
+                _dtype.endianness = Endian::NATIVE;
+            // Validates the dtype
+            __npy_visit(_dtype, [](auto) {});
+
+            // fortran_order
+            pos = _find_value(header, "fortran_order");
+            _fortran_order = header.compare(pos, 4, "True") == 0;
+
+            // shape
+            pos = _find_value(header, "shape");
+            end = header.find(')', pos);
+            if (pos == std::string::npos || header[pos] != '(' || end == std::string::npos)
+                throw std::runtime_error("NumPy header is malformed!");
+            for (std::size_t i=pos+1; i<end; ) {
+                i = header.find_first_of("0123456789", i);
+                if (i >= end)
+                    break;
+                std::size_t n_digits = header.find_first_not_of("0123456789", i) - i;
+                _shape.push_back(_parse_number(header.substr(i, n_digits)));
+                i += n_digits;
+            }
+
+            for (auto dimension : _shape) {
+                // A wrapped product could pass the truncation check below
+                if (dimension != 0 && _n_elements > std::numeric_limits<std::size_t>::max() / dimension)
+                    throw std::runtime_error("NumPy array shape is too large!");
+                _n_elements *= dimension;
+            }
+            if ((size - _data_offset) / _dtype.size < _n_elements)
+                throw std::runtime_error("NumPy file is truncated!");
+        }
+    };
+
+
+    ///
+    /// @brief Writer of NumPy `.npy` files.
+    ///
+    class NpyWriter
+    {
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Writes an array as a `.npy` file to a binary stream.
+        ///
+        /// @tparam ENDIANNESS_V Byte order of the written elements. Data is copied as is when this matches the host.
+        /// @tparam T Element type. Either `bool`, an integer type, `float` or `double`.
+        /// @param s Binary stream to write to.
+        /// @param values Pointer to the elements, in row-major (C) order.
+        /// @param shape Dimensions of the array.
+        ///
+        template <Endian ENDIANNESS_V=Endian::LITTLE, typename T>
+        static void write(std::ostream& s, const T* values, const std::vector<std::size_t>& shape)
+        {
+            const NpyDtype dtype = NpyDtype::of<T>(ENDIANNESS_V);
+
+            // Formatted as a Python tuple, which needs a trailing comma when it has a single element
+            std::size_t n_elements = 1;
+            std::string shape_str = "(";
+            for (std::size_t i=0; i<shape.size(); i++) {
+                n_elements *= shape[i];
+                shape_str += (i ? ", " : "") + std::to_string(shape[i]);
+            }
+            shape_str += shape.size() == 1 ? ",)" : ")";
+
+            std::string header = "{'descr': '" + dtype.descr() + "', 'fortran_order': False, 'shape': " + shape_str + ", }";
+
+            // Pad with spaces and a terminating newline, so that the data starts aligned. Version 1 stores the size of
+            // the padded header in 16 bits, so the version is chosen on that size
+            auto padded_size = [&](std::size_t prefix_size) {
+                const std::size_t total = prefix_size + header.size() + 1;
+                return total + (__NPY_ALIGNMENT - total % __NPY_ALIGNMENT) % __NPY_ALIGNMENT - prefix_size;
+            };
+            const bool is_v1 = padded_size(__NPY_MAGIC_SIZE + 4) <= 0xFFFF;
+            const std::size_t prefix_size = __NPY_MAGIC_SIZE + 2 + (is_v1 ? 2 : 4);
+            header.append(padded_size(prefix_size) - header.size() - 1, ' ');
+            header += '\n';
+
+            std::vector<std::uint8_t> prefix(__NPY_MAGIC, __NPY_MAGIC + __NPY_MAGIC_SIZE);
+            prefix.push_back(is_v1 ? 1 : 2);
+            prefix.push_back(0);
+            if (is_v1)
+                u16_IO::pack<Endian::LITTLE>(static_cast<std::uint16_t>(header.size()), prefix);
+            else
+                u32_IO::pack<Endian::LITTLE>(static_cast<std::uint32_t>(header.size()), prefix);
+
+            s.write(reinterpret_cast<const char*>(prefix.data()), static_cast<std::streamsize>(prefix.size()));
+            s.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+            if constexpr (sizeof(T) == 1 || ENDIANNESS_V == Endian::NATIVE)
+            {
+                s.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(n_elements * sizeof(T)));
+            }
+            else
+            {
+                using IO_T = std::conditional_t<std::is_same_v<T, float>,  fp32_IO,
+                             std::conditional_t<std::is_same_v<T, double>, fp64_IO,
+                                                                           IntIO<T>>>;
+                BufferPool::Buffer buffer = BufferPool::local().acquire(n_elements * sizeof(T));
+                IO_T::template pack<ENDIANNESS_V>(values, n_elements, buffer.data());
+                s.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+            }
+        }
+
+        ///
+        /// @brief Writes a one-dimensional array as a `.npy` file to a binary stream.
+        ///
+        /// @tparam ENDIANNESS_V Byte order of the written elements. Data is copied as is when this matches the host.
+        /// @tparam T Element type. Either `bool`, an integer type, `float` or `double`.
+        /// @param s Binary stream to write to.
+        /// @param values Elements to write.
+        ///
+        template <Endian ENDIANNESS_V=Endian::LITTLE, typename T>
+        static void write(std::ostream& s, const std::vector<T>& values)
+        { write<ENDIANNESS_V>(s, values.data(), {values.size()}); }
+
+        ///
+        /// @brief Writes a one-dimensional array of bools as a `.npy` file to a binary stream. `std::vector<bool>` is
+        /// packed into bits, so the elements are unpacked into a temporary array first.
+        ///
+        /// @tparam ENDIANNESS_V Byte order of the written elements, which has no effect on bools.
+        /// @param s Binary stream to write to.
+        /// @param values Elements to write.
+        ///
+        template <Endian ENDIANNESS_V=Endian::LITTLE>
+        static void write(std::ostream& s, const std::vector<bool>& values)
+        {
+            std::unique_ptr<bool[]> unpacked(new bool[values.size()]);
+            std::copy(values.begin(), values.end(), unpacked.get());
+            write<ENDIANNESS_V>(s, unpacked.get(), {values.size()});
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_NPY_H */
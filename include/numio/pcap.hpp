@@ -0,0 +1,404 @@
+#ifndef NUMIO_PCAP_H
+#define NUMIO_PCAP_H
+
+// ****************************************************************************
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../numio.hpp"
+#include "mmap.hpp"
+#include "std.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    namespace {
+        static constexpr std::uint32_t __PCAP_MAGIC_USEC = 0xA1B2C3D4u;
+        static constexpr std::uint32_t __PCAP_MAGIC_NSEC = 0xA1B23C4Du;
+        static constexpr std::size_t __PCAP_HEADER_SIZE = 24;
+        static constexpr std::size_t __PCAP_RECORD_HEADER_SIZE = 16;
+
+        static constexpr std::uint32_t __PCAPNG_SECTION_HEADER = 0x0A0D0D0Au;
+        static constexpr std::uint32_t __PCAPNG_INTERFACE_DESCRIPTION = 0x00000001u;
+        static constexpr std::uint32_t __PCAPNG_SIMPLE_PACKET = 0x00000003u;
+        static constexpr std::uint32_t __PCAPNG_ENHANCED_PACKET = 0x00000006u;
+        static constexpr std::uint32_t __PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4Du;
+    }
+
+    ///
+    /// @brief Container formats of packet captures.
+    ///
+    enum class CaptureFormat
+    {
+        /// Classic libpcap format.
+        PCAP   = 0,
+        /// PCAP Next Generation format.
+        PCAPNG = 1,
+    };
+
+    ///
+    /// @brief A captured packet. The payload points directly into the mapped capture file.
+    ///
+    struct PcapPacket
+    {
+        /// Capture time in nanoseconds since the Unix epoch.
+        std::uint64_t timestamp = 0;
+        /// Length of the packet on the wire, which may exceed the captured `size`.
+        std::uint32_t original_length = 0;
+        /// Index of the capturing interface. Always 0 for the classic pcap format.
+        std::uint32_t interface_id = 0;
+        /// Link-layer header type of the capturing interface (`LINKTYPE_*` value).
+        std::uint16_t link_type = 0;
+        /// Pointer to the first byte of the captured payload.
+        const std::uint8_t* data = nullptr;
+        /// Amount of captured payload bytes.
+        std::size_t size = 0;
+    };
+
+    ///
+    /// @brief Reader of pcap and pcapng packet captures.
+    ///
+    /// The file is memory mapped and its byte order is detected from the magic number (or per section for pcapng).
+    /// Headers are then decoded by a reading function instantiated for that byte order, so no per-field branches on the
+    /// byte order are needed. Packet payloads are not copied.
+    ///
+    class PcapReader
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        struct _Interface
+        {
+            std::uint16_t link_type;
+            // Timestamp resolution, in negative powers of 10 or of 2
+            std::uint8_t resolution;
+            bool is_binary_resolution;
+        };
+
+        using _READ_FUNCTION = bool (PcapReader::*)(PcapPacket&);
+
+        MappedFile _file;
+        CaptureFormat _format;
+        Endian _endianness;
+        std::size_t _offset;
+        std::vector<_Interface> _interfaces;
+        _READ_FUNCTION _read_function;
+
+
+        // :: CONSTRUCTORS :: //
+        public:
+
+        ///
+        /// @brief Opens a capture file by memory mapping it.
+        ///
+        /// @param path Path of the file to open.
+        /// @throws std::runtime_error If the file can't be mapped or is not a pcap or pcapng file.
+        ///
+        explicit PcapReader(const std::string& path)
+            : _file(path)
+        {
+            if (_file.size() < 12)
+                throw std::runtime_error("Data is not a pcap or pcapng file!");
+
+            if (u32_IO::unpack<Endian::LITTLE>(_file.data()) == __PCAPNG_SECTION_HEADER)
+                _format = CaptureFormat::PCAPNG;
+            else if (_is_pcap_magic(u32_IO::unpack<Endian::LITTLE>(_file.data())))
+                _format = CaptureFormat::PCAP;
+            else
+                throw std::runtime_error("Data is not a pcap or pcapng file!");
+
+            rewind();
+        }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns the container format of the capture.
+        ///
+        CaptureFormat format() const
+        { return _format; }
+
+        ///
+        /// @brief Returns the byte order of the capture (of the current section for pcapng).
+        ///
+        Endian endianness() const
+        { return _endianness; }
+
+        ///
+        /// @brief Restarts reading from the first packet.
+        ///
+        void rewind()
+        {
+            _interfaces.clear();
+            if (_format == CaptureFormat::PCAP)
+            {
+                if (_file.size() < __PCAP_HEADER_SIZE)
+                    throw std::runtime_error("pcap header is truncated!");
+                const std::uint32_t magic = u32_IO::unpack<Endian::LITTLE>(_file.data());
+                const bool is_nanoseconds = magic == __PCAP_MAGIC_NSEC || _byte_swap(magic) == __PCAP_MAGIC_NSEC;
+                _endianness = magic == __PCAP_MAGIC_USEC || magic == __PCAP_MAGIC_NSEC ? Endian::LITTLE : Endian::BIG;
+                std::uint32_t link_type = _endianness == Endian::LITTLE
+                    ? u32_IO::unpack<Endian::LITTLE>(_file.data() + 20)
+                    : u32_IO::unpack<Endian::BIG>(_file.data() + 20);
+                _interfaces.push_back({static_cast<std::uint16_t>(link_type), static_cast<std::uint8_t>(is_nanoseconds ? 9 : 6), false});
+                _offset = __PCAP_HEADER_SIZE;
+            }
+            else
+            {
+                _endianness = _detect_pcapng_endianness(_file.data());
+                _offset = 0;
+            }
+            _select_read_function();
+        }
+
+        ///
+        /// @brief Reads the next packet.
+        ///
+        /// @param packet Packet to store the header values and payload location in.
+        /// @return False if there are no more packets.
+        /// @throws std::runtime_error If the capture is malformed or truncated.
+        ///
+        bool next(PcapPacket& packet)
+        {
+            while (!(this->*_read_function)(packet)) {
+                // A pcapng section with a different byte order stops the read function before its header
+                if (_offset >= _file.size())
+                    return false;
+                _select_read_function();
+            }
+            return true;
+        }
+
+        ///
+        /// @brief Calls a function for every remaining packet.
+        ///
+        /// The whole scan runs in a loop specialized for the byte order, without indirect calls per packet.
+        ///
+        /// @param func Function taking a `const PcapPacket&`.
+        /// @return Amount of packets visited.
+        ///
+        template <typename FUNC_T>
+        std::size_t for_each(FUNC_T&& func)
+        {
+            std::size_t count = 0;
+            while (_offset < _file.size())
+            {
+                if (_format == CaptureFormat::PCAP)
+                    count += _endianness == Endian::LITTLE ? _scan<Endian::LITTLE, CaptureFormat::PCAP>(func)
+                                                          : _scan<Endian::BIG, CaptureFormat::PCAP>(func);
+                else
+                    count += _endianness == Endian::LITTLE ? _scan<Endian::LITTLE, CaptureFormat::PCAPNG>(func)
+                                                          : _scan<Endian::BIG, CaptureFormat::PCAPNG>(func);
+            }
+            return count;
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        static std::uint32_t _byte_swap(std::uint32_t value)
+        { return (value >> 24) | ((value >> 8) & 0xFF00u) | ((value << 8) & 0xFF0000u) | (value << 24); }
+
+        // Returns true if the magic number, read as little endian, is a pcap magic number in either byte order
+        static bool _is_pcap_magic(std::uint32_t magic)
+        {
+            return magic == __PCAP_MAGIC_USEC || magic == __PCAP_MAGIC_NSEC
+                || _byte_swap(magic) == __PCAP_MAGIC_USEC || _byte_swap(magic) == __PCAP_MAGIC_NSEC;
+        }
+
+        static Endian _detect_pcapng_endianness(const std::uint8_t* block)
+        {
+            const std::uint32_t magic = u32_IO::unpack<Endian::LITTLE>(block + 8);
+            if (magic == __PCAPNG_BYTE_ORDER_MAGIC)
+                return Endian::LITTLE;
+            if (u32_IO::unpack<Endian::BIG>(block + 8) == __PCAPNG_BYTE_ORDER_MAGIC)
+                return Endian::BIG;
+            throw std::runtime_error("pcapng section header has an invalid byte order magic!");
+        }
+
+        void _select_read_function()
+        {
+            if (_format == CaptureFormat::PCAP)
+                _read_function = _endianness == Endian::LITTLE ? &PcapReader::_read<Endian::LITTLE, CaptureFormat::PCAP>
+                                                               : &PcapReader::_read<Endian::BIG, CaptureFormat::PCAP>;
+            else
+                _read_function = _endianness == Endian::LITTLE ? &PcapReader::_read<Endian::LITTLE, CaptureFormat::PCAPNG>
+                                                               : &PcapReader::_read<Endian::BIG, CaptureFormat::PCAPNG>;
+        }
+
+        template <Endian ENDIANNESS_V, CaptureFormat FORMAT_V, typename FUNC_T>
+        std::size_t _scan(FUNC_T& func)
+        {
+            std::size_t count = 0;
+            PcapPacket packet;
+            while (_read<ENDIANNESS_V, FORMAT_V>(packet)) {
+                func(static_cast<const PcapPacket&>(packet));
+                count++;
+            }
+            return count;
+        }
+
+        // Converts a timestamp in units of the interface resolution to nanoseconds
+        static std::uint64_t _to_nanoseconds(std::uint64_t timestamp, const _Interface& interface)
+        {
+            static constexpr std::uint64_t POWERS_OF_10[] = {
+                1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull
+            };
+            const unsigned int resolution = interface.resolution;
+            if (interface.is_binary_resolution) {
+                if (resolution >= 64)
+                    return 0;
+                const std::uint64_t seconds = timestamp >> resolution;
+                const std::uint64_t fraction = timestamp - (seconds << resolution);
+                return seconds * 1000000000ull
+                     + static_cast<std::uint64_t>(static_cast<long double>(fraction) * 1e9L / static_cast<long double>(1ull << resolution));
+            }
+            if (resolution <= 9)
+                return timestamp * POWERS_OF_10[9 - resolution];
+            std::uint64_t divisor = 1;
+            for (unsigned int i=9; i<resolution && divisor; i++)
+                divisor *= 10;
+            return divisor ? timestamp / divisor : 0;
+        }
+
+        // Reads the next packet of the current byte order. Returns false at the end of the file, or at a pcapng section
+        // header of the other byte order, after updating `_endianness`.
+        template <Endian ENDIANNESS_V, CaptureFormat FORMAT_V>
+        bool _read(PcapPacket& packet)
+        {
+            const std::uint8_t* bytes = _file.data();
+            const std::size_t size = _file.size();
+
+            if constexpr (FORMAT_V == CaptureFormat::PCAP)
+            {
+                if (_offset >= size)
+                    return false;
+                if (_offset + __PCAP_RECORD_HEADER_SIZE > size)
+                    throw std::runtime_error("pcap record header is truncated!");
+
+                // ts_sec, ts_usec (or ts_nsec), incl_len, orig_len
+                std::uint32_t fields[4];
+                u32_IO::unpack<ENDIANNESS_V>(bytes + _offset, 4, fields);
+                _offset += __PCAP_RECORD_HEADER_SIZE;
+                if (_offset + fields[2] > size)
+                    throw std::runtime_error("pcap record is truncated!");
+
+                const _Interface& interface = _interfaces[0];
+                packet.timestamp = static_cast<std::uint64_t>(fields[0]) * 1000000000ull
+                                 + static_cast<std::uint64_t>(fields[1]) * (interface.resolution == 9 ? 1u : 1000u);
+                packet.original_length = fields[3];
+                packet.interface_id = 0;
+                packet.link_type = interface.link_type;
+                packet.data = bytes + _offset;
+                packet.size = fields[2];
+                _offset += fields[2];
+                return true;
+            }
+            else
+            {
+                while (_offset < size)
+                {
+                    if (_offset + 12 > size)
+                        throw std::runtime_error("pcapng block is truncated!");
+                    const std::uint8_t* block = bytes + _offset;
+
+                    // Block type and total length
+                    std::uint32_t header[2];
+                    u32_IO::unpack<ENDIANNESS_V>(block, 2, header);
+
+                    if (header[0] == __PCAPNG_SECTION_HEADER) {
+                        Endian endianness = _detect_pcapng_endianness(block);
+                        if (endianness != ENDIANNESS_V) {
+                            _endianness = endianness;
+                            return false;
+                        }
+                        // Interface IDs are local to a section
+                        _interfaces.clear();
+                    }
+
+                    const std::uint32_t length = header[1];
+                    if (length < 12 || length % 4 || _offset + length > size)
+                        throw std::runtime_error("pcapng block has an invalid length!");
+                    _offset += length;
+
+                    switch (header[0])
+                    {
+                        case __PCAPNG_INTERFACE_DESCRIPTION:
+                        {
+                            if (length < 20)
+                                throw std::runtime_error("pcapng interface description block is truncated!");
+                            _Interface interface = {u16_IO::unpack<ENDIANNESS_V>(block + 8), 6, false};
+                            // Options of code, length and padded value, looking for if_tsresol
+                            std::size_t option = 16;
+                            while (option + 4 <= length - 4) {
+                                std::uint16_t code_length[2];
+                                u16_IO::unpack<ENDIANNESS_V>(block + option, 2, code_length);
+                                if (code_length[0] == 0)
+                                    break;
+                                if (code_length[0] == 9 && code_length[1] >= 1 && option + 5 <= length - 4) {
+                                    interface.is_binary_resolution = (block[option + 4] & 0x80) != 0;
+                                    interface.resolution = block[option + 4] & 0x7F;
+                                }
+                                option += 4 + ((code_length[1] + 3u) & ~3u);
+                            }
+                            _interfaces.push_back(interface);
+                            break;
+                        }
+                        case __PCAPNG_ENHANCED_PACKET:
+                        {
+                            if (length < 32)
+                                throw std::runtime_error("pcapng enhanced packet block is truncated!");
+                            // Interface ID, timestamp (high), timestamp (low), captured length, original length
+                            std::uint32_t fields[5];
+                            u32_IO::unpack<ENDIANNESS_V>(block + 8, 5, fields);
+                            if (fields[0] >= _interfaces.size())
+                                throw std::runtime_error("pcapng packet refers to an undefined interface!");
+                            if (fields[3] > length - 32)
+                                throw std::runtime_error("pcapng packet is truncated!");
+
+                            const _Interface& interface = _interfaces[fields[0]];
+                            packet.timestamp = _to_nanoseconds((static_cast<std::uint64_t>(fields[1]) << 32) | fields[2], interface);
+                            packet.original_length = fields[4];
+                            packet.interface_id = fields[0];
+                            packet.link_type = interface.link_type;
+                            packet.data = block + 28;
+                            packet.size = fields[3];
+                            return true;
+                        }
+                        case __PCAPNG_SIMPLE_PACKET:
+                        {
+                            if (length < 16)
+                                throw std::runtime_error("pcapng simple packet block is truncated!");
+                            if (_interfaces.empty())
+                                throw std::runtime_error("pcapng packet refers to an undefined interface!");
+                            // The captured length is implied by the block length
+                            const std::uint32_t original_length = u32_IO::unpack<ENDIANNESS_V>(block + 8);
+                            packet.timestamp = 0;
+                            packet.original_length = original_length;
+                            packet.interface_id = 0;
+                            packet.link_type = _interfaces[0].link_type;
+                            packet.data = block + 12;
+                            packet.size = std::min<std::size_t>(original_length, length - 16);
+                            return true;
+                        }
+                        default:
+                            break;
+                    }
+                }
+                return false;
+            }
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_PCAP_H */
@@ -0,0 +1,282 @@
+#ifndef NUMIO_PCM_H
+#define NUMIO_PCM_H
+
+// ****************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "../numio.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    namespace {
+        // Integer hash (lowbias32) used as a counter-based random number generator. Since every output only
+        // depends on its counter, loops generating noise have no carried state and can be vectorized
+        static inline std::uint32_t __hash32(std::uint32_t x)
+        {
+            x ^= x >> 16;
+            x *= 0x7FEB352Du;
+            x ^= x >> 15;
+            x *= 0x846CA68Bu;
+            x ^= x >> 16;
+            return x;
+        }
+    }
+
+    ///
+    /// @brief Counter-based generator of triangular probability density function (TPDF) dither noise.
+    ///
+    /// Noise is in the range of [-1, 1) LSB of the target format. The generator keeps track of its position, so that
+    /// consecutive blocks of samples continue the noise sequence.
+    ///
+    class TpdfDither
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        std::uint32_t _seed;
+        std::uint32_t _position;
+
+
+        // :: CONSTRUCTORS :: //
+        public:
+
+        ///
+        /// @brief Constructs a dither noise generator.
+        ///
+        /// @param seed Seed of the noise sequence.
+        ///
+        explicit TpdfDither(std::uint32_t seed=0x9E3779B9u)
+            : _seed(seed), _position(0)
+        {}
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns the noise value for the sample at a given distance from the current position.
+        ///
+        /// @tparam FLOAT_T Float type to return.
+        /// @param i Distance from the current position.
+        /// @return Noise value in LSB.
+        ///
+        template <typename FLOAT_T>
+        FLOAT_T noise(std::uint32_t i) const
+        {
+            std::uint32_t h = __hash32((_position + i) ^ _seed);
+            // Sum of two independent uniform values results in a triangular distribution
+            return static_cast<FLOAT_T>(static_cast<std::int32_t>((h & 0xFFFF) + (h >> 16)) - 0x10000)
+                 * static_cast<FLOAT_T>(1.0 / 0x10000);
+        }
+
+        ///
+        /// @brief Advances the current position of the noise sequence.
+        ///
+        /// @param n Amount of samples to advance.
+        ///
+        void advance(std::size_t n)
+        { _position += static_cast<std::uint32_t>(n); }
+    };
+
+
+    ///
+    /// @brief Template class for converting packed integer PCM samples from and to normalized floats.
+    ///
+    /// Signed samples are mapped to the range of [-1, 1), unsigned (offset binary) samples are centered around their
+    /// midpoint first. Conversion happens in a single pass straight from and to the packed data.
+    ///
+    /// @tparam INT_IO_T Integer I/O type of the packed samples, e.g. `NumIO::i24_IO`.
+    ///
+    template <typename INT_IO_T>
+    class PcmIO
+    {
+        // :: PRIVATE ATTRIBUTES & HELPER FUNCTIONS :: //
+        private:
+
+        using _INT_T = typename INT_IO_T::value_type;
+        static constexpr unsigned int _N_BITS = INT_IO_T::N_VALUE_BITS;
+        static_assert(_N_BITS >= 2 && _N_BITS <= 32, "PCM samples must have between 2 and 32 bits!");
+
+        // Scale factor calculations are done in double precision if FLOAT_T can't represent every sample value
+        template <typename FLOAT_T>
+        using _CALC_T = std::conditional_t<(_N_BITS > std::numeric_limits<FLOAT_T>::digits), double, FLOAT_T>;
+
+        static constexpr std::int64_t _FULL_SCALE = static_cast<std::int64_t>(1) << (_N_BITS - 1);
+        static constexpr std::int64_t _OFFSET = std::is_signed_v<_INT_T> ? 0 : _FULL_SCALE;
+
+        template <typename FLOAT_T, bool DITHER_V>
+        static _INT_T _quantize(FLOAT_T value, const TpdfDither* dither, std::uint32_t i)
+        {
+            using CALC_T = _CALC_T<FLOAT_T>;
+            constexpr CALC_T MIN = static_cast<CALC_T>(-_FULL_SCALE);
+            constexpr CALC_T MAX = static_cast<CALC_T>(_FULL_SCALE - 1);
+
+            CALC_T v = static_cast<CALC_T>(value) * static_cast<CALC_T>(_FULL_SCALE);
+            if constexpr (DITHER_V)
+                v += dither->template noise<CALC_T>(i);
+
+            // Written as selects so that the loop is vectorizable, which on x86-64 takes SSE4.1 for the rounding. NaN
+            // is mapped to silence
+            v = std::nearbyint(v);
+            v = std::min(std::max(v, MIN), MAX);
+            v = (v == v) ? v : static_cast<CALC_T>(0);
+
+            // Clipped value always fits in 32 bits; offset binary wraps around as intended
+            return static_cast<_INT_T>(
+                static_cast<std::uint32_t>(static_cast<std::int32_t>(v)) + static_cast<std::uint32_t>(_OFFSET)
+            );
+        }
+
+        template <Endian ENDIANNESS_V, bool DITHER_V, typename FLOAT_T>
+        static void _pack(const FLOAT_T* values, std::size_t count, std::uint8_t* bytes, std::size_t stride,
+                          const TpdfDither* dither)
+        {
+            for (std::size_t i=0; i<count; i++) {
+                INT_IO_T::template pack<ENDIANNESS_V>(
+                    _quantize<FLOAT_T, DITHER_V>(values[i], dither, static_cast<std::uint32_t>(i)),
+                    bytes + i * stride
+                );
+            }
+        }
+
+
+        // :: PUBLIC ATTRIBUTES :: //
+        public:
+
+        ///
+        /// @brief The amount of bytes used for a packed sample.
+        ///
+        static constexpr int N_IO_BYTES = INT_IO_T::N_IO_BYTES;
+
+
+        // :: UNPACKING FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Unpacks PCM samples from a buffer of bytes into normalized floats.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam FLOAT_T Float type to convert to.
+        /// @param bytes Pointer to the first byte of the packed samples.
+        /// @param count Amount of samples.
+        /// @param out Output buffer receiving `count` float values.
+        /// @param stride Distance in bytes between the starts of consecutive samples, e.g. the frame size of
+        ///        interleaved channels. Defaults to `N_IO_BYTES`.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename FLOAT_T>
+        static void unpack(const std::uint8_t* bytes, std::size_t count, FLOAT_T* out, std::size_t stride=N_IO_BYTES)
+        {
+            static_assert(std::is_floating_point_v<FLOAT_T>, "Template parameter FLOAT_T must be a float type!");
+            using CALC_T = _CALC_T<FLOAT_T>;
+            constexpr CALC_T SCALE = static_cast<CALC_T>(1) / static_cast<CALC_T>(_FULL_SCALE);
+
+            for (std::size_t i=0; i<count; i++) {
+                auto sample = INT_IO_T::template unpack<ENDIANNESS_V>(bytes + i * stride);
+                out[i] = static_cast<FLOAT_T>(static_cast<CALC_T>(static_cast<std::int64_t>(sample) - _OFFSET) * SCALE);
+            }
+        }
+
+        ///
+        /// @brief Unpacks PCM samples from a vector of bytes into normalized floats.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam FLOAT_T Float type to convert to.
+        /// @param bytes Vector of bytes holding the packed samples.
+        /// @param out Vector receiving the float values. Resized to the amount of samples in `bytes`.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename FLOAT_T>
+        static void unpack(const std::vector<std::uint8_t>& bytes, std::vector<FLOAT_T>& out)
+        {
+            out.resize(bytes.size() / N_IO_BYTES);
+            unpack<ENDIANNESS_V>(bytes.data(), out.size(), out.data());
+        }
+
+
+        // :: PACKING FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Packs normalized floats into a buffer of bytes as PCM samples, rounding to nearest even and clipping.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam FLOAT_T Float type to convert from.
+        /// @param values Input float values.
+        /// @param count Amount of samples.
+        /// @param bytes Pointer to the first byte to write to.
+        /// @param stride Distance in bytes between the starts of consecutive samples. Defaults to `N_IO_BYTES`.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename FLOAT_T>
+        static void pack(const FLOAT_T* values, std::size_t count, std::uint8_t* bytes, std::size_t stride=N_IO_BYTES)
+        {
+            static_assert(std::is_floating_point_v<FLOAT_T>, "Template parameter FLOAT_T must be a float type!");
+            _pack<ENDIANNESS_V, false>(values, count, bytes, stride, nullptr);
+        }
+
+        ///
+        /// @brief Packs normalized floats into a buffer of bytes as PCM samples, applying TPDF dither before rounding
+        ///        to nearest even and clipping.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam FLOAT_T Float type to convert from.
+        /// @param values Input float values.
+        /// @param count Amount of samples.
+        /// @param bytes Pointer to the first byte to write to.
+        /// @param dither Dither noise generator. Advanced by `count` samples.
+        /// @param stride Distance in bytes between the starts of consecutive samples. Defaults to `N_IO_BYTES`.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename FLOAT_T>
+        static void pack(const FLOAT_T* values, std::size_t count, std::uint8_t* bytes, TpdfDither& dither,
+                         std::size_t stride=N_IO_BYTES)
+        {
+            static_assert(std::is_floating_point_v<FLOAT_T>, "Template parameter FLOAT_T must be a float type!");
+            _pack<ENDIANNESS_V, true>(values, count, bytes, stride, &dither);
+            dither.advance(count);
+        }
+
+        ///
+        /// @brief Packs normalized floats into a vector of bytes as PCM samples, rounding to nearest even and clipping.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam FLOAT_T Float type to convert from.
+        /// @param values Input float values.
+        /// @param bytes Vector of bytes to append to.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename FLOAT_T>
+        static void pack(const std::vector<FLOAT_T>& values, std::vector<std::uint8_t>& bytes)
+        {
+            auto offset = bytes.size();
+            bytes.resize(offset + values.size() * N_IO_BYTES);
+            pack<ENDIANNESS_V>(values.data(), values.size(), bytes.data() + offset);
+        }
+
+        ///
+        /// @brief Packs normalized floats into a vector of bytes as PCM samples, applying TPDF dither before rounding
+        ///        to nearest even and clipping.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @tparam FLOAT_T Float type to convert from.
+        /// @param values Input float values.
+        /// @param bytes Vector of bytes to append to.
+        /// @param dither Dither noise generator. Advanced by the amount of samples.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, typename FLOAT_T>
+        static void pack(const std::vector<FLOAT_T>& values, std::vector<std::uint8_t>& bytes, TpdfDither& dither)
+        {
+            auto offset = bytes.size();
+            bytes.resize(offset + values.size() * N_IO_BYTES);
+            pack<ENDIANNESS_V>(values.data(), values.size(), bytes.data() + offset, dither);
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_PCM_H */
@@ -0,0 +1,303 @@
+#ifndef NUMIO_POOL_H
+#define NUMIO_POOL_H
+
+// ****************************************************************************
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    ///
+    /// @brief Usage statistics of a `BufferPool`.
+    ///
+    struct BufferPoolStats
+    {
+        /// Amount of buffers acquired.
+        std::size_t n_acquired = 0;
+        /// Amount of acquired buffers that were recycled instead of allocated.
+        std::size_t n_hits = 0;
+        /// Capacity in bytes of the buffers currently acquired.
+        std::size_t bytes_in_use = 0;
+        /// Highest value of `bytes_in_use`.
+        std::size_t peak_bytes_in_use = 0;
+        /// Capacity in bytes of the buffers held for recycling.
+        std::size_t bytes_cached = 0;
+
+        ///
+        /// @brief Returns the fraction of acquired buffers that were recycled, or 0 if none were acquired.
+        ///
+        double hit_rate() const
+        { return n_acquired ? static_cast<double>(n_hits) / static_cast<double>(n_acquired) : 0.0; }
+    };
+
+
+    ///
+    /// @brief Pool of scratch buffers, recycled per power-of-two size class, to keep allocation out of steady-state
+    /// (de)serialization loops.
+    ///
+    /// A pool is not thread-safe. `local()` returns a pool for the calling thread; its buffers must be released on
+    /// that thread before it exits.
+    ///
+    class BufferPool
+    {
+        // :: PUBLIC ATTRIBUTES :: //
+        public:
+
+        ///
+        /// @brief Capacity of the smallest size class in bytes.
+        ///
+        static constexpr std::size_t MIN_CLASS_SIZE = 64;
+
+        ///
+        /// @brief Amount of size classes. Larger buffers are allocated and freed directly.
+        ///
+        static constexpr unsigned int N_SIZE_CLASSES = 19;
+
+        ///
+        /// @brief Capacity of the largest size class in bytes (16 MiB).
+        ///
+        static constexpr std::size_t MAX_CLASS_SIZE = MIN_CLASS_SIZE << (N_SIZE_CLASSES - 1);
+
+
+        ///
+        /// @brief Scratch buffer acquired from a pool, returned to it when destroyed.
+        ///
+        class Buffer
+        {
+            // :: PRIVATE ATTRIBUTES :: //
+            private:
+
+            BufferPool* _pool = nullptr;
+            std::uint8_t* _data = nullptr;
+            std::size_t _size = 0;
+            std::size_t _capacity = 0;
+
+            friend class BufferPool;
+
+            Buffer(BufferPool* pool, std::uint8_t* data, std::size_t size, std::size_t capacity)
+                : _pool(pool), _data(data), _size(size), _capacity(capacity)
+            {}
+
+
+            // :: CONSTRUCTORS & DESTRUCTOR :: //
+            public:
+
+            ///
+            /// @brief Constructs an empty buffer, not belonging to a pool.
+            ///
+            Buffer() = default;
+
+            Buffer(const Buffer&) = delete;
+            Buffer& operator=(const Buffer&) = delete;
+
+            Buffer(Buffer&& other) noexcept
+                : _pool(std::exchange(other._pool, nullptr)), _data(std::exchange(other._data, nullptr)),
+                  _size(std::exchange(other._size, 0)), _capacity(std::exchange(other._capacity, 0))
+            {}
+
+            Buffer& operator=(Buffer&& other) noexcept
+            {
+                if (this != &other) {
+                    release();
+                    _pool = std::exchange(other._pool, nullptr);
+                    _data = std::exchange(other._data, nullptr);
+                    _size = std::exchange(other._size, 0);
+                    _capacity = std::exchange(other._capacity, 0);
+                }
+                return *this;
+            }
+
+            ~Buffer()
+            { release(); }
+
+
+            // :: PUBLIC FUNCTIONS :: //
+            public:
+
+            ///
+            /// @brief Returns a pointer to the first byte. The contents are not initialized.
+            ///
+            std::uint8_t* data()
+            { return _data; }
+
+            const std::uint8_t* data() const
+            { return _data; }
+
+            ///
+            /// @brief Returns the requested size in bytes.
+            ///
+            std::size_t size() const
+            { return _size; }
+
+            ///
+            /// @brief Returns the usable size in bytes, which is rounded up to the size class.
+            ///
+            std::size_t capacity() const
+            { return _capacity; }
+
+            ///
+            /// @brief Changes the size within the capacity.
+            ///
+            /// @throws std::runtime_error If the size exceeds the capacity.
+            ///
+            void resize(std::size_t size)
+            {
+                if (size > _capacity)
+                    throw std::runtime_error("Size exceeds the capacity of the pooled buffer!");
+                _size = size;
+            }
+
+            ///
+            /// @brief Returns the buffer to its pool before destruction.
+            ///
+            void release()
+            {
+                if (_pool)
+                    _pool->_release(_data, _capacity);
+                _pool = nullptr;
+                _data = nullptr;
+                _size = 0;
+                _capacity = 0;
+            }
+        };
+
+
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        std::vector<std::uint8_t*> _free_lists[N_SIZE_CLASSES];
+        std::size_t _max_cached_per_class;
+        BufferPoolStats _stats;
+
+
+        // :: CONSTRUCTORS & DESTRUCTOR :: //
+        public:
+
+        ///
+        /// @brief Constructs an empty pool.
+        ///
+        /// @param max_cached_per_class Maximum amount of released buffers kept per size class. Buffers released beyond
+        ///        this are freed.
+        ///
+        explicit BufferPool(std::size_t max_cached_per_class=8)
+            : _max_cached_per_class(max_cached_per_class)
+        {}
+
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        ~BufferPool()
+        { trim(); }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns the pool of the calling thread.
+        ///
+        static BufferPool& local()
+        {
+            thread_local BufferPool pool;
+            return pool;
+        }
+
+        ///
+        /// @brief Acquires a buffer of at least the given size, recycling a released one of the same size class if
+        /// available.
+        ///
+        /// @param size Size in bytes.
+        ///
+        Buffer acquire(std::size_t size)
+        {
+            const unsigned int size_class = _size_class(size);
+            const std::size_t capacity = size_class < N_SIZE_CLASSES ? MIN_CLASS_SIZE << size_class : size;
+
+            std::uint8_t* data;
+            if (size_class < N_SIZE_CLASSES && !_free_lists[size_class].empty()) {
+                data = _free_lists[size_class].back();
+                _free_lists[size_class].pop_back();
+                _stats.bytes_cached -= capacity;
+                _stats.n_hits++;
+            }
+            else
+                data = static_cast<std::uint8_t*>(::operator new(capacity));
+
+            _stats.n_acquired++;
+            _stats.bytes_in_use += capacity;
+            if (_stats.bytes_in_use > _stats.peak_bytes_in_use)
+                _stats.peak_bytes_in_use = _stats.bytes_in_use;
+            return Buffer(this, data, size, capacity);
+        }
+
+        ///
+        /// @brief Frees all buffers held for recycling.
+        ///
+        void trim()
+        {
+            for (auto& free_list : _free_lists) {
+                for (std::uint8_t* data : free_list)
+                    ::operator delete(data);
+                free_list.clear();
+            }
+            _stats.bytes_cached = 0;
+        }
+
+        ///
+        /// @brief Returns the usage statistics.
+        ///
+        const BufferPoolStats& stats() const
+        { return _stats; }
+
+        ///
+        /// @brief Resets the counters and the peak usage, keeping the current usage.
+        ///
+        void reset_stats()
+        {
+            _stats.n_acquired = 0;
+            _stats.n_hits = 0;
+            _stats.peak_bytes_in_use = _stats.bytes_in_use;
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        // Index of the smallest size class that fits, or N_SIZE_CLASSES if none does
+        static unsigned int _size_class(std::size_t size)
+        {
+            unsigned int size_class = 0;
+            std::size_t capacity = MIN_CLASS_SIZE;
+            while (capacity < size && size_class < N_SIZE_CLASSES) {
+                capacity <<= 1;
+                size_class++;
+            }
+            return size_class;
+        }
+
+        void _release(std::uint8_t* data, std::size_t capacity)
+        {
+            _stats.bytes_in_use -= capacity;
+            const unsigned int size_class = _size_class(capacity);
+            if (size_class < N_SIZE_CLASSES && (MIN_CLASS_SIZE << size_class) == capacity &&
+                _free_lists[size_class].size() < _max_cached_per_class)
+            {
+                _free_lists[size_class].push_back(data);
+                _stats.bytes_cached += capacity;
+            }
+            else
+                ::operator delete(data);
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_POOL_H */
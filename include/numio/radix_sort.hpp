@@ -0,0 +1,202 @@
+#ifndef NUMIO_RADIX_SORT_H
+#define NUMIO_RADIX_SORT_H
+
+// ****************************************************************************
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../numio.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    ///
+    /// @brief Radix sort of packed keys, operating directly on their bytes.
+    ///
+    /// Keys are compared as unsigned big endian byte strings (`memcmp` order), which is the order of the values for
+    /// the order-preserving key types of `numio/key.hpp`, and of unsigned integers packed big endian. The sort is a
+    /// stable least significant digit radix sort with one pass per key byte. The histograms of all bytes are counted
+    /// in a single pass, and passes over bytes that are equal for all keys are skipped. Counting and scattering are
+    /// divided over multiple threads.
+    ///
+    class RadixSort
+    {
+        // :: PRIVATE ATTRIBUTES & HELPER FUNCTIONS :: //
+        private:
+
+        // Below this amount of records per thread, extra threads cost more than they gain
+        static constexpr std::size_t _MIN_RECORDS_PER_THREAD = 1 << 16;
+
+        using _HISTOGRAM = std::array<std::size_t, 256>;
+
+        template <typename FUNC_T>
+        static void _parallel(unsigned int n_threads, FUNC_T&& func)
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(n_threads - 1);
+            for (unsigned int t=1; t<n_threads; t++)
+                threads.emplace_back(func, t);
+            func(0u);
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        template <std::size_t RECORD_SIZE_V>
+        static void _copy(std::uint8_t* dst, const std::uint8_t* src, std::size_t record_size)
+        {
+            if constexpr (RECORD_SIZE_V)
+                std::memcpy(dst, src, RECORD_SIZE_V);
+            else
+                std::memcpy(dst, src, record_size);
+        }
+
+        template <std::size_t RECORD_SIZE_V>
+        static void _sort(std::uint8_t* records, std::size_t count, std::size_t record_size, std::size_t key_size,
+                          unsigned int n_threads)
+        {
+            if (count < 2 || key_size == 0)
+                return;
+            if (RECORD_SIZE_V)
+                record_size = RECORD_SIZE_V;
+
+            if (n_threads == 0)
+                n_threads = std::max(1u, std::thread::hardware_concurrency());
+            n_threads = static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(n_threads, count / _MIN_RECORDS_PER_THREAD)));
+
+            auto slice_begin = [count, n_threads](unsigned int t) { return count * t / n_threads; };
+
+            // Histograms per thread and key byte
+            std::vector<_HISTOGRAM> histograms(static_cast<std::size_t>(n_threads) * key_size);
+            _parallel(n_threads, [&](unsigned int t) {
+                _HISTOGRAM* histogram = histograms.data() + t * key_size;
+                for (std::size_t b=0; b<key_size; b++)
+                    histogram[b].fill(0);
+                for (std::size_t i=slice_begin(t); i<slice_begin(t + 1); i++) {
+                    const std::uint8_t* key = records + i * record_size;
+                    for (std::size_t b=0; b<key_size; b++)
+                        histogram[b][key[b]]++;
+                }
+            });
+
+            std::vector<std::uint8_t> buffer(count * record_size);
+            std::uint8_t* src = records;
+            std::uint8_t* dst = buffer.data();
+            std::vector<_HISTOGRAM> offsets(n_threads);
+
+            for (std::size_t b=key_size; b-->0;)
+            {
+                // Skip the pass if all keys have the same byte
+                bool is_constant = false;
+                for (unsigned int v=0; v<256 && !is_constant; v++) {
+                    std::size_t total = 0;
+                    for (unsigned int t=0; t<n_threads; t++)
+                        total += histograms[t * key_size + b][v];
+                    is_constant = total == count;
+                }
+                if (is_constant)
+                    continue;
+
+                // Each thread scatters its slice to its own range within every bucket, which keeps the sort stable
+                std::size_t position = 0;
+                for (unsigned int v=0; v<256; v++) {
+                    for (unsigned int t=0; t<n_threads; t++) {
+                        offsets[t][v] = position;
+                        position += histograms[t * key_size + b][v];
+                    }
+                }
+
+                _parallel(n_threads, [&](unsigned int t) {
+                    _HISTOGRAM& offset = offsets[t];
+                    for (std::size_t i=slice_begin(t); i<slice_begin(t + 1); i++) {
+                        const std::uint8_t* record = src + i * record_size;
+                        _copy<RECORD_SIZE_V>(dst + offset[record[b]]++ * record_size, record, record_size);
+                    }
+                });
+
+                // The histograms of the other bytes are per slice, so they must be recounted for the new order
+                if (n_threads > 1 && b > 0) {
+                    _parallel(n_threads, [&](unsigned int t) {
+                        _HISTOGRAM* histogram = histograms.data() + t * key_size;
+                        for (std::size_t c=0; c<b; c++)
+                            histogram[c].fill(0);
+                        for (std::size_t i=slice_begin(t); i<slice_begin(t + 1); i++) {
+                            const std::uint8_t* key = dst + i * record_size;
+                            for (std::size_t c=0; c<b; c++)
+                                histogram[c][key[c]]++;
+                        }
+                    });
+                }
+
+                std::swap(src, dst);
+            }
+
+            if (src != records)
+                std::memcpy(records, src, count * record_size);
+        }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Sorts consecutive packed keys in place.
+        ///
+        /// @tparam KEY_IO_T IO type of the keys, e.g. `NumIO::i40_key_IO`.
+        /// @param keys Pointer to the first byte of the first key.
+        /// @param count Amount of keys.
+        /// @param n_threads Amount of threads, or 0 for the amount of hardware threads. Small inputs use fewer threads.
+        ///
+        template <typename KEY_IO_T>
+        static void sort(std::uint8_t* keys, std::size_t count, unsigned int n_threads=0)
+        { _sort<KEY_IO_T::N_IO_BYTES>(keys, count, KEY_IO_T::N_IO_BYTES, KEY_IO_T::N_IO_BYTES, n_threads); }
+
+        ///
+        /// @brief Sorts fixed-size records in place by a key at the start of each record.
+        ///
+        /// @param records Pointer to the first byte of the first record.
+        /// @param count Amount of records.
+        /// @param record_size Size of a record in bytes.
+        /// @param key_size Size of the key in bytes, at most `record_size`.
+        /// @param n_threads Amount of threads, or 0 for the amount of hardware threads. Small inputs use fewer threads.
+        /// @throws std::invalid_argument If the key is larger than the record.
+        ///
+        static void sort(std::uint8_t* records, std::size_t count, std::size_t record_size, std::size_t key_size,
+                         unsigned int n_threads=0)
+        {
+            if (key_size > record_size)
+                throw std::invalid_argument("Key size can't be larger than the record size!");
+            switch (record_size) {
+                case 1:  _sort<1>(records, count, record_size, key_size, n_threads); break;
+                case 2:  _sort<2>(records, count, record_size, key_size, n_threads); break;
+                case 3:  _sort<3>(records, count, record_size, key_size, n_threads); break;
+                case 4:  _sort<4>(records, count, record_size, key_size, n_threads); break;
+                case 5:  _sort<5>(records, count, record_size, key_size, n_threads); break;
+                case 6:  _sort<6>(records, count, record_size, key_size, n_threads); break;
+                case 8:  _sort<8>(records, count, record_size, key_size, n_threads); break;
+                case 12: _sort<12>(records, count, record_size, key_size, n_threads); break;
+                case 16: _sort<16>(records, count, record_size, key_size, n_threads); break;
+                default: _sort<0>(records, count, record_size, key_size, n_threads); break;
+            }
+        }
+
+        ///
+        /// @brief Sorts a vector of consecutive packed keys in place.
+        ///
+        /// @tparam KEY_IO_T IO type of the keys, e.g. `NumIO::i40_key_IO`.
+        ///
+        template <typename KEY_IO_T>
+        static void sort(std::vector<std::uint8_t>& keys, unsigned int n_threads=0)
+        { sort<KEY_IO_T>(keys.data(), keys.size() / KEY_IO_T::N_IO_BYTES, n_threads); }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_RADIX_SORT_H */
@@ -0,0 +1,223 @@
+#ifndef NUMIO_REQUANTIZE_H
+#define NUMIO_REQUANTIZE_H
+
+// ****************************************************************************
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "../numio.hpp"
+#include "pcm.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    ///
+    /// @brief Methods of reducing the bit depth of integer samples.
+    ///
+    enum class Requantization
+    {
+        /// Discard the low bits (rounds towards negative infinity).
+        TRUNCATE    = 0,
+        /// Round to nearest, ties away from negative infinity.
+        ROUND       = 1,
+        /// Add TPDF dither noise of the discarded bits before rounding.
+        DITHER      = 2,
+        /// Dither and feed back the quantization error of the previous sample of the same channel (first-order
+        /// high-pass noise shaping).
+        NOISE_SHAPE = 3,
+    };
+
+    ///
+    /// @brief Template class for converting packed integer samples between two integer formats in a single pass.
+    ///
+    /// Widening shifts the samples up and is exact. Narrowing discards the low bits according to a `Requantization`
+    /// method, clipping to the range of the target format. Signedness may differ between formats, in which case
+    /// unsigned samples are treated as offset binary.
+    ///
+    /// @tparam SRC_IO_T Integer I/O type of the input samples, e.g. `NumIO::i24_IO`.
+    /// @tparam DST_IO_T Integer I/O type of the output samples, e.g. `NumIO::i16_IO`.
+    ///
+    template <typename SRC_IO_T, typename DST_IO_T>
+    class Requantizer
+    {
+        // :: PRIVATE ATTRIBUTES & HELPER FUNCTIONS :: //
+        private:
+
+        using _SRC_T = typename SRC_IO_T::value_type;
+        using _DST_T = typename DST_IO_T::value_type;
+
+        static constexpr int _SRC_BITS = SRC_IO_T::N_VALUE_BITS;
+        static constexpr int _DST_BITS = DST_IO_T::N_VALUE_BITS;
+        static_assert(_SRC_BITS <= 62 && _DST_BITS <= 62, "Samples wider than 62 bits are not supported!");
+
+        // Amount of bits discarded when narrowing, negative when widening
+        static constexpr int _SHIFT = _SRC_BITS - _DST_BITS;
+
+        // Use 32-bit arithmetic whenever intermediate values can't overflow, which vectorizes far better
+        using _CALC_T = std::conditional_t<(std::max(_SRC_BITS, _DST_BITS) + 2 <= 32), std::int32_t, std::int64_t>;
+
+        static constexpr _CALC_T _SRC_OFFSET = std::is_signed_v<_SRC_T> ? 0 : static_cast<_CALC_T>(1) << (_SRC_BITS - 1);
+        static constexpr _CALC_T _DST_OFFSET = std::is_signed_v<_DST_T> ? 0 : static_cast<_CALC_T>(1) << (_DST_BITS - 1);
+        static constexpr _CALC_T _DST_MIN = -(static_cast<_CALC_T>(1) << (_DST_BITS - 1));
+        static constexpr _CALC_T _DST_MAX = (static_cast<_CALC_T>(1) << (_DST_BITS - 1)) - 1;
+
+        Requantization _method;
+        unsigned int _n_channels;
+        std::uint32_t _seed;
+        std::uint32_t _position;
+        std::vector<_CALC_T> _errors;
+        // Channel of the next sample, as blocks need not hold a whole amount of frames
+        unsigned int _channel;
+
+        // Returns symmetric triangular noise in the range of (-2^_SHIFT, 2^_SHIFT), in units of the input format
+        _CALC_T _noise(std::uint32_t i) const
+        {
+            std::uint32_t h1 = __hash32((_position + i) ^ _seed);
+            std::uint32_t h2 = __hash32(h1);
+            if constexpr (_SHIFT >= 32) {
+                return (static_cast<_CALC_T>(h1) - static_cast<_CALC_T>(h2)) * (static_cast<_CALC_T>(1) << (_SHIFT - 32));
+            }
+            else {
+                return static_cast<_CALC_T>(h1 >> (32 - _SHIFT)) - static_cast<_CALC_T>(h2 >> (32 - _SHIFT));
+            }
+        }
+
+        static _DST_T _to_output(_CALC_T value)
+        {
+            value = std::min(std::max(value, _DST_MIN), _DST_MAX);
+            return static_cast<_DST_T>(value + _DST_OFFSET);
+        }
+
+        template <Endian SRC_ENDIANNESS_V, Endian DST_ENDIANNESS_V, Requantization METHOD_V>
+        void _process(const std::uint8_t* in, std::size_t count, std::uint8_t* out)
+        {
+            static constexpr _CALC_T HALF = METHOD_V == Requantization::TRUNCATE
+                ? 0
+                : static_cast<_CALC_T>(1) << (_SHIFT - 1);
+
+            if constexpr (METHOD_V == Requantization::NOISE_SHAPE)
+            {
+                // Error feedback has a dependency on the previous sample of the channel, so this is inherently serial
+                static constexpr _CALC_T MAX_ERROR = static_cast<_CALC_T>(1) << _SHIFT;
+                unsigned int channel = _channel;
+                for (std::size_t i=0; i<count; i++)
+                {
+                    _CALC_T x = static_cast<_CALC_T>(SRC_IO_T::template unpack<SRC_ENDIANNESS_V>(in + i * SRC_IO_T::N_IO_BYTES))
+                              - _SRC_OFFSET
+                              - _errors[channel];
+                    _CALC_T q = std::min(std::max((x + _noise(static_cast<std::uint32_t>(i)) + HALF) >> _SHIFT, _DST_MIN), _DST_MAX);
+                    // Limit the error that is fed back, so that clipping can't make the feedback loop run away
+                    _errors[channel] = std::min(std::max(q * MAX_ERROR - x, -MAX_ERROR), MAX_ERROR);
+
+                    DST_IO_T::template pack<DST_ENDIANNESS_V>(static_cast<_DST_T>(q + _DST_OFFSET), out + i * DST_IO_T::N_IO_BYTES);
+
+                    if (++channel == _n_channels)
+                        channel = 0;
+                }
+                _channel = channel;
+            }
+            else
+            {
+                for (std::size_t i=0; i<count; i++)
+                {
+                    _CALC_T x = static_cast<_CALC_T>(SRC_IO_T::template unpack<SRC_ENDIANNESS_V>(in + i * SRC_IO_T::N_IO_BYTES))
+                              - _SRC_OFFSET;
+                    if constexpr (METHOD_V == Requantization::DITHER)
+                        x += _noise(static_cast<std::uint32_t>(i));
+
+                    DST_IO_T::template pack<DST_ENDIANNESS_V>(_to_output((x + HALF) >> _SHIFT), out + i * DST_IO_T::N_IO_BYTES);
+                }
+            }
+
+            _position += static_cast<std::uint32_t>(count);
+        }
+
+
+        // :: CONSTRUCTORS :: //
+        public:
+
+        ///
+        /// @brief Constructs a requantizer.
+        ///
+        /// @param method Method used when narrowing. Ignored when widening.
+        /// @param n_channels Amount of interleaved channels, used to keep track of the error per channel when noise
+        ///        shaping.
+        /// @param seed Seed of the dither noise sequence.
+        ///
+        explicit Requantizer(Requantization method=Requantization::ROUND, unsigned int n_channels=1,
+                             std::uint32_t seed=0x9E3779B9u)
+            : _method(method), _n_channels(n_channels ? n_channels : 1), _seed(seed), _position(0),
+              _errors(_n_channels, 0), _channel(0)
+        {}
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Converts packed samples from a buffer of bytes into another buffer of bytes.
+        ///
+        /// @tparam SRC_ENDIANNESS_V Defines the endianness of the input data.
+        /// @tparam DST_ENDIANNESS_V Defines the endianness of the output data.
+        /// @param in Pointer to the first byte of the input samples.
+        /// @param count Amount of samples.
+        /// @param out Pointer to the first byte to write to. Exactly `count * DST_IO_T::N_IO_BYTES` bytes are written.
+        ///
+        template <Endian SRC_ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, Endian DST_ENDIANNESS_V=SRC_ENDIANNESS_V>
+        void process(const std::uint8_t* in, std::size_t count, std::uint8_t* out)
+        {
+            if constexpr (_SHIFT <= 0)
+            {
+                static constexpr _CALC_T SCALE = static_cast<_CALC_T>(1) << -_SHIFT;
+                for (std::size_t i=0; i<count; i++) {
+                    _CALC_T x = static_cast<_CALC_T>(SRC_IO_T::template unpack<SRC_ENDIANNESS_V>(in + i * SRC_IO_T::N_IO_BYTES))
+                              - _SRC_OFFSET;
+                    DST_IO_T::template pack<DST_ENDIANNESS_V>(static_cast<_DST_T>(x * SCALE + _DST_OFFSET), out + i * DST_IO_T::N_IO_BYTES);
+                }
+            }
+            else
+            {
+                switch (_method)
+                {
+                    case Requantization::TRUNCATE:
+                        _process<SRC_ENDIANNESS_V, DST_ENDIANNESS_V, Requantization::TRUNCATE>(in, count, out);
+                        break;
+                    case Requantization::ROUND:
+                        _process<SRC_ENDIANNESS_V, DST_ENDIANNESS_V, Requantization::ROUND>(in, count, out);
+                        break;
+                    case Requantization::DITHER:
+                        _process<SRC_ENDIANNESS_V, DST_ENDIANNESS_V, Requantization::DITHER>(in, count, out);
+                        break;
+                    case Requantization::NOISE_SHAPE:
+                        _process<SRC_ENDIANNESS_V, DST_ENDIANNESS_V, Requantization::NOISE_SHAPE>(in, count, out);
+                        break;
+                }
+            }
+        }
+
+        ///
+        /// @brief Converts packed samples from a vector of bytes into another vector of bytes.
+        ///
+        /// @tparam SRC_ENDIANNESS_V Defines the endianness of the input data.
+        /// @tparam DST_ENDIANNESS_V Defines the endianness of the output data.
+        /// @param in Vector of bytes holding the input samples.
+        /// @param out Vector of bytes to append the output samples to.
+        ///
+        template <Endian SRC_ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, Endian DST_ENDIANNESS_V=SRC_ENDIANNESS_V>
+        void process(const std::vector<std::uint8_t>& in, std::vector<std::uint8_t>& out)
+        {
+            std::size_t count = in.size() / SRC_IO_T::N_IO_BYTES;
+            auto offset = out.size();
+            out.resize(offset + count * DST_IO_T::N_IO_BYTES);
+            process<SRC_ENDIANNESS_V, DST_ENDIANNESS_V>(in.data(), count, out.data() + offset);
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_REQUANTIZE_H */
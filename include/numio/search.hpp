@@ -0,0 +1,210 @@
+#ifndef NUMIO_SEARCH_H
+#define NUMIO_SEARCH_H
+
+// ****************************************************************************
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "../numio.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    ///
+    /// @brief Template class for searching sorted arrays of packed values, e.g. memory mapped index files. Only the
+    /// probed elements are unpacked.
+    ///
+    /// Besides the usual binary searches, there are branchless variants (of which the loop compiles to conditional
+    /// moves) and searches over the Eytzinger layout, which stores the implicit binary search tree in breadth-first
+    /// order so that the first levels share cache lines.
+    ///
+    /// @tparam IO_T `IntIO` or `FloatIO` type of the packed values.
+    ///
+    template <typename IO_T>
+    class PackedSearch
+    {
+        // :: PRIVATE ATTRIBUTES & HELPER FUNCTIONS :: //
+        private:
+
+        using _T = typename IO_T::value_type;
+
+        template <Endian ENDIANNESS_V>
+        static _T _at(const std::uint8_t* bytes, std::size_t index, std::size_t stride)
+        { return IO_T::template unpack<ENDIANNESS_V>(bytes + index * stride); }
+
+        // Whether the element lies before the searched position
+        template <bool IS_UPPER_V>
+        static bool _is_before(_T element, _T value)
+        { return IS_UPPER_V ? !(value < element) : element < value; }
+
+        template <bool IS_UPPER_V, Endian ENDIANNESS_V>
+        static std::size_t _bound(const std::uint8_t* bytes, std::size_t count, _T value, std::size_t stride)
+        {
+            std::size_t first = 0;
+            while (count > 0) {
+                const std::size_t half = count / 2;
+                if (_is_before<IS_UPPER_V>(_at<ENDIANNESS_V>(bytes, first + half, stride), value)) {
+                    first += half + 1;
+                    count -= half + 1;
+                }
+                else
+                    count = half;
+            }
+            return first;
+        }
+
+        template <bool IS_UPPER_V, Endian ENDIANNESS_V>
+        static std::size_t _bound_branchless(const std::uint8_t* bytes, std::size_t count, _T value, std::size_t stride)
+        {
+            if (count == 0)
+                return 0;
+            // The result lies in [first, first + count]
+            std::size_t first = 0;
+            while (count > 1) {
+                const std::size_t half = count / 2;
+                first += _is_before<IS_UPPER_V>(_at<ENDIANNESS_V>(bytes, first + half, stride), value) ? half : 0;
+                count -= half;
+            }
+            return first + _is_before<IS_UPPER_V>(_at<ENDIANNESS_V>(bytes, first, stride), value);
+        }
+
+        template <bool IS_UPPER_V, Endian ENDIANNESS_V>
+        static std::size_t _eytzinger_bound(const std::uint8_t* bytes, std::size_t count, _T value, std::size_t stride)
+        {
+            // Descend using 1-based node numbers, going right while the node lies before the searched position
+            std::size_t node = 1;
+            while (node <= count)
+                node = 2 * node + _is_before<IS_UPPER_V>(_at<ENDIANNESS_V>(bytes, node - 1, stride), value);
+            // The result is the last node where the search went left: strip the trailing right turns and that left turn
+            while (node & 1)
+                node >>= 1;
+            node >>= 1;
+            return node ? node - 1 : count;
+        }
+
+        static void _eytzinger_fill(const std::uint8_t* sorted, std::size_t count, std::uint8_t* out,
+                                    std::size_t stride, std::size_t& index, std::size_t node)
+        {
+            if (node > count)
+                return;
+            _eytzinger_fill(sorted, count, out, stride, index, 2 * node);
+            std::memcpy(out + (node - 1) * stride, sorted + index * stride, stride);
+            index++;
+            _eytzinger_fill(sorted, count, out, stride, index, 2 * node + 1);
+        }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns the index of the first element that is not less than a value, or `count` if there is none.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data.
+        /// @param bytes Pointer to the first byte of the sorted packed values.
+        /// @param count Amount of values.
+        /// @param value Value to search for.
+        /// @param stride Distance in bytes between the starts of consecutive values, e.g. the size of an index entry.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static std::size_t lower_bound(const std::uint8_t* bytes, std::size_t count, _T value,
+                                       std::size_t stride=IO_T::N_IO_BYTES)
+        { return _bound<false, ENDIANNESS_V>(bytes, count, value, stride); }
+
+        ///
+        /// @brief Returns the index of the first element that is greater than a value, or `count` if there is none.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data.
+        /// @param bytes Pointer to the first byte of the sorted packed values.
+        /// @param count Amount of values.
+        /// @param value Value to search for.
+        /// @param stride Distance in bytes between the starts of consecutive values, e.g. the size of an index entry.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static std::size_t upper_bound(const std::uint8_t* bytes, std::size_t count, _T value,
+                                       std::size_t stride=IO_T::N_IO_BYTES)
+        { return _bound<true, ENDIANNESS_V>(bytes, count, value, stride); }
+
+        ///
+        /// @brief Returns the range of indices of elements equal to a value, as `[first, last)`.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data.
+        /// @param bytes Pointer to the first byte of the sorted packed values.
+        /// @param count Amount of values.
+        /// @param value Value to search for.
+        /// @param stride Distance in bytes between the starts of consecutive values, e.g. the size of an index entry.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static std::pair<std::size_t, std::size_t> equal_range(const std::uint8_t* bytes, std::size_t count, _T value,
+                                                               std::size_t stride=IO_T::N_IO_BYTES)
+        {
+            const std::size_t first = lower_bound<ENDIANNESS_V>(bytes, count, value, stride);
+            // The upper bound can only lie at or after the lower bound
+            const std::size_t last = first + upper_bound<ENDIANNESS_V>(bytes + first * stride, count - first, value, stride);
+            return {first, last};
+        }
+
+        ///
+        /// @brief Same as `lower_bound()`, but without data-dependent branches. This is faster when the probed
+        /// elements are cached, as mispredictions cost more than the extra probes.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static std::size_t lower_bound_branchless(const std::uint8_t* bytes, std::size_t count, _T value,
+                                                  std::size_t stride=IO_T::N_IO_BYTES)
+        { return _bound_branchless<false, ENDIANNESS_V>(bytes, count, value, stride); }
+
+        ///
+        /// @brief Same as `upper_bound()`, but without data-dependent branches.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static std::size_t upper_bound_branchless(const std::uint8_t* bytes, std::size_t count, _T value,
+                                                  std::size_t stride=IO_T::N_IO_BYTES)
+        { return _bound_branchless<true, ENDIANNESS_V>(bytes, count, value, stride); }
+
+        ///
+        /// @brief Reorders sorted packed elements into the Eytzinger layout.
+        ///
+        /// @param sorted Pointer to the first byte of the sorted elements.
+        /// @param count Amount of elements.
+        /// @param out Pointer to write `count * stride` bytes to. Must not overlap with `sorted`.
+        /// @param stride Size of an element in bytes. Whole elements are moved, so e.g. index entries keep their payload.
+        ///
+        static void to_eytzinger(const std::uint8_t* sorted, std::size_t count, std::uint8_t* out,
+                                 std::size_t stride=IO_T::N_IO_BYTES)
+        {
+            std::size_t index = 0;
+            _eytzinger_fill(sorted, count, out, stride, index, 1);
+        }
+
+        ///
+        /// @brief Returns the position in an Eytzinger layout of the first element that is not less than a value, or
+        /// `count` if there is none.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data.
+        /// @param bytes Pointer to the first byte of the elements in Eytzinger layout, see `to_eytzinger()`.
+        /// @param count Amount of elements.
+        /// @param value Value to search for.
+        /// @param stride Distance in bytes between the starts of consecutive elements.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static std::size_t eytzinger_lower_bound(const std::uint8_t* bytes, std::size_t count, _T value,
+                                                 std::size_t stride=IO_T::N_IO_BYTES)
+        { return _eytzinger_bound<false, ENDIANNESS_V>(bytes, count, value, stride); }
+
+        ///
+        /// @brief Returns the position in an Eytzinger layout of the first element that is greater than a value, or
+        /// `count` if there is none.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static std::size_t eytzinger_upper_bound(const std::uint8_t* bytes, std::size_t count, _T value,
+                                                 std::size_t stride=IO_T::N_IO_BYTES)
+        { return _eytzinger_bound<true, ENDIANNESS_V>(bytes, count, value, stride); }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_SEARCH_H */
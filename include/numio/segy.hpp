@@ -0,0 +1,401 @@
+#ifndef NUMIO_SEGY_H
+#define NUMIO_SEGY_H
+
+// ****************************************************************************
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../numio.hpp"
+#include "mmap.hpp"
+#include "std.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    namespace {
+        static constexpr std::size_t __SEGY_TEXTUAL_HEADER_SIZE = 3200;
+        static constexpr std::size_t __SEGY_HEADER_SIZE = 3600;
+        static constexpr std::size_t __SEGY_TRACE_HEADER_SIZE = 240;
+
+        // Converts an IBM System/360 single precision hexadecimal float. The fraction scaled by a power of two is
+        // exact in double precision, so only the final conversion to float rounds.
+        static inline float __ibm_to_float(std::uint32_t bits)
+        {
+            const std::uint32_t fraction = bits & 0x00FFFFFFu;
+            const int exponent = static_cast<int>((bits >> 24) & 0x7Fu);
+            // 0.fraction * 16^(exponent - 64) = fraction * 2^(4 * exponent - 256 - 24)
+            const std::uint64_t scale_bits = static_cast<std::uint64_t>(1023 + 4 * exponent - 280) << 52;
+            double scale;
+            std::memcpy(&scale, &scale_bits, sizeof(scale));
+            const double value = static_cast<double>(fraction) * scale;
+            return static_cast<float>(bits >> 31 ? -value : value);
+        }
+    }
+
+    ///
+    /// @brief Data sample format codes of SEG-Y files.
+    ///
+    enum class SegyFormat : std::uint16_t
+    {
+        IBM_FLOAT   = 1,
+        INT32       = 2,
+        INT16       = 3,
+        IEEE_FLOAT  = 5,
+        IEEE_DOUBLE = 6,
+        INT24       = 7,
+        INT8        = 8,
+        INT64       = 9,
+        UINT32      = 10,
+        UINT16      = 11,
+        UINT64      = 12,
+        UINT24      = 15,
+        UINT8       = 16,
+    };
+
+    ///
+    /// @brief Commonly used fields of a SEG-Y trace header.
+    ///
+    struct SegyTraceHeader
+    {
+        std::int32_t trace_sequence_line = 0;
+        std::int32_t trace_sequence_file = 0;
+        std::int32_t field_record = 0;
+        std::int32_t cdp = 0;
+        /// Scalar to apply to the coordinates: a multiplier when positive, a divisor when negative.
+        std::int16_t coordinate_scalar = 0;
+        std::int32_t source_x = 0;
+        std::int32_t source_y = 0;
+        std::uint16_t n_samples = 0;
+        /// Sample interval in microseconds (or Hz, mm, m).
+        std::uint16_t sample_interval = 0;
+        std::int32_t cdp_x = 0;
+        std::int32_t cdp_y = 0;
+        std::int32_t inline_number = 0;
+        std::int32_t crossline_number = 0;
+    };
+
+
+    ///
+    /// @brief Reader of SEG-Y seismic trace files.
+    ///
+    /// The file is memory mapped and the location of every trace is indexed when opening. Headers are decoded as big
+    /// endian, unless the SEG-Y revision 2 byte order field indicates little endian. Trace samples are converted to
+    /// `float`, optionally in parallel over multiple threads.
+    ///
+    class SegyReader
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        MappedFile _file;
+        Endian _endianness;
+        SegyFormat _format;
+        std::size_t _sample_size;
+        std::uint16_t _sample_interval;
+        // Offset of every trace header, with one extra entry for the end of the last trace
+        std::vector<std::size_t> _offsets;
+
+
+        // :: CONSTRUCTORS :: //
+        public:
+
+        ///
+        /// @brief Opens a SEG-Y file by memory mapping it, and indexes its traces.
+        ///
+        /// @param path Path of the file to open.
+        /// @throws std::runtime_error If the file can't be mapped, is malformed or uses an unsupported sample format.
+        ///
+        explicit SegyReader(const std::string& path)
+            : _file(path)
+        {
+            if (_file.size() < __SEGY_HEADER_SIZE)
+                throw std::runtime_error("Data is not a SEG-Y file!");
+
+            // Revision 2 files may be little endian, which is signalled by 0x01020304 in the file's byte order
+            _endianness = u32_IO::unpack<Endian::LITTLE>(_file.data() + 3296) == 0x01020304u
+                ? Endian::LITTLE
+                : Endian::BIG;
+
+            if (_endianness == Endian::LITTLE)
+                _index<Endian::LITTLE>();
+            else
+                _index<Endian::BIG>();
+        }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns the byte order of the headers and samples.
+        ///
+        Endian endianness() const
+        { return _endianness; }
+
+        ///
+        /// @brief Returns the data sample format.
+        ///
+        SegyFormat format() const
+        { return _format; }
+
+        ///
+        /// @brief Returns the sample interval of the binary file header, in microseconds (or Hz, mm, m).
+        ///
+        std::uint16_t sample_interval() const
+        { return _sample_interval; }
+
+        ///
+        /// @brief Returns the textual file header, usually EBCDIC encoded.
+        ///
+        std::string textual_header() const
+        { return std::string(reinterpret_cast<const char*>(_file.data()), __SEGY_TEXTUAL_HEADER_SIZE); }
+
+        ///
+        /// @brief Returns a pointer to the 400-byte binary file header.
+        ///
+        const std::uint8_t* binary_header() const
+        { return _file.data() + __SEGY_TEXTUAL_HEADER_SIZE; }
+
+        ///
+        /// @brief Returns the amount of traces.
+        ///
+        std::size_t n_traces() const
+        { return _offsets.size() - 1; }
+
+        ///
+        /// @brief Returns the amount of samples of a trace.
+        ///
+        std::size_t n_samples(std::size_t trace) const
+        { return (_offsets.at(trace + 1) - _offsets[trace] - __SEGY_TRACE_HEADER_SIZE) / _sample_size; }
+
+        ///
+        /// @brief Returns a pointer to the raw 240-byte header of a trace.
+        ///
+        const std::uint8_t* trace_header_data(std::size_t trace) const
+        { return _file.data() + _offsets.at(trace); }
+
+        ///
+        /// @brief Decodes the commonly used fields of a trace header.
+        ///
+        SegyTraceHeader trace_header(std::size_t trace) const
+        {
+            return _endianness == Endian::LITTLE ? _trace_header<Endian::LITTLE>(trace_header_data(trace))
+                                                 : _trace_header<Endian::BIG>(trace_header_data(trace));
+        }
+
+        ///
+        /// @brief Decodes the samples of a trace.
+        ///
+        /// @param trace Index of the trace.
+        /// @param out Pointer to write `n_samples(trace)` samples to.
+        ///
+        void read_trace(std::size_t trace, float* out) const
+        { read_traces(trace, 1, out, 1); }
+
+        ///
+        /// @brief Decodes the samples of a range of traces, concatenated.
+        ///
+        /// @param first Index of the first trace.
+        /// @param count Amount of traces.
+        /// @param out Pointer to write the samples of all traces to, one trace after the other.
+        /// @param n_threads Amount of threads to divide the traces over, or 0 for the amount of hardware threads.
+        /// @throws std::out_of_range If the range of traces is out of bounds.
+        ///
+        void read_traces(std::size_t first, std::size_t count, float* out, unsigned int n_threads=0) const
+        {
+            if (first + count > n_traces())
+                throw std::out_of_range("SEG-Y trace range is out of bounds!");
+            if (n_threads == 0)
+                n_threads = std::max(1u, std::thread::hardware_concurrency());
+            n_threads = static_cast<unsigned int>(std::min<std::size_t>(n_threads, count));
+
+            if (n_threads <= 1) {
+                _decode_traces(first, count, out);
+                return;
+            }
+
+            // Divide the traces in equal parts; the output position of each part follows from the trace offsets
+            std::vector<std::thread> threads;
+            threads.reserve(n_threads - 1);
+            for (unsigned int t=0; t<n_threads; t++)
+            {
+                const std::size_t begin = first + count * t / n_threads;
+                const std::size_t end = first + count * (t + 1) / n_threads;
+                float* part = out + _n_samples_between(first, begin);
+                if (t + 1 == n_threads)
+                    _decode_traces(begin, end - begin, part);
+                else
+                    threads.emplace_back([this, begin, end, part]() { _decode_traces(begin, end - begin, part); });
+            }
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        ///
+        /// @brief Decodes the samples of a range of traces into a vector, concatenated.
+        ///
+        /// @param first Index of the first trace.
+        /// @param count Amount of traces.
+        /// @param n_threads Amount of threads to divide the traces over, or 0 for the amount of hardware threads.
+        ///
+        std::vector<float> read_traces(std::size_t first, std::size_t count, unsigned int n_threads=0) const
+        {
+            if (first + count > n_traces())
+                throw std::out_of_range("SEG-Y trace range is out of bounds!");
+            std::vector<float> result(_n_samples_between(first, first + count));
+            read_traces(first, count, result.data(), n_threads);
+            return result;
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        std::size_t _n_samples_between(std::size_t begin, std::size_t end) const
+        { return (_offsets[end] - _offsets[begin] - (end - begin) * __SEGY_TRACE_HEADER_SIZE) / _sample_size; }
+
+        static std::size_t _sample_size_of(SegyFormat format)
+        {
+            switch (format) {
+                case SegyFormat::INT8: case SegyFormat::UINT8:
+                    return 1;
+                case SegyFormat::INT16: case SegyFormat::UINT16:
+                    return 2;
+                case SegyFormat::INT24: case SegyFormat::UINT24:
+                    return 3;
+                case SegyFormat::IBM_FLOAT: case SegyFormat::INT32: case SegyFormat::UINT32: case SegyFormat::IEEE_FLOAT:
+                    return 4;
+                case SegyFormat::IEEE_DOUBLE: case SegyFormat::INT64: case SegyFormat::UINT64:
+                    return 8;
+                default:
+                    return 0;
+            }
+        }
+
+        template <Endian ENDIANNESS_V>
+        void _index()
+        {
+            const std::uint8_t* bytes = _file.data();
+            const std::size_t size = _file.size();
+            const std::uint8_t* header = bytes + __SEGY_TEXTUAL_HEADER_SIZE;
+
+            _sample_interval = u16_IO::unpack<ENDIANNESS_V>(header + 16);
+            _format = static_cast<SegyFormat>(u16_IO::unpack<ENDIANNESS_V>(header + 24));
+            _sample_size = _sample_size_of(_format);
+            if (_sample_size == 0)
+                throw std::runtime_error("SEG-Y sample format " + std::to_string(static_cast<int>(_format)) + " is not supported!");
+
+            std::size_t n_samples = u16_IO::unpack<ENDIANNESS_V>(header + 20);
+            // Revision 2 extended samples per trace
+            if (n_samples == 0)
+                n_samples = u32_IO::unpack<ENDIANNESS_V>(header + 68);
+            const bool is_fixed_length = u16_IO::unpack<ENDIANNESS_V>(header + 302) == 1;
+            const std::int16_t n_extended_headers = i16_IO::unpack<ENDIANNESS_V>(header + 304);
+            if (n_extended_headers < 0)
+                throw std::runtime_error("SEG-Y files with a variable amount of extended textual headers are not supported!");
+
+            std::size_t offset = __SEGY_HEADER_SIZE + static_cast<std::size_t>(n_extended_headers) * __SEGY_TEXTUAL_HEADER_SIZE;
+            _offsets.clear();
+            if (is_fixed_length)
+            {
+                const std::size_t trace_size = __SEGY_TRACE_HEADER_SIZE + n_samples * _sample_size;
+                const std::size_t count = offset <= size ? (size - offset) / trace_size : 0;
+                _offsets.resize(count + 1);
+                for (std::size_t i=0; i<=count; i++)
+                    _offsets[i] = offset + i * trace_size;
+            }
+            else
+            {
+                // Each trace header states its own amount of samples, falling back on the file header
+                while (offset + __SEGY_TRACE_HEADER_SIZE <= size)
+                {
+                    std::size_t n_trace_samples = u16_IO::unpack<ENDIANNESS_V>(bytes + offset + 114);
+                    if (n_trace_samples == 0)
+                        n_trace_samples = n_samples;
+                    const std::size_t trace_size = __SEGY_TRACE_HEADER_SIZE + n_trace_samples * _sample_size;
+                    if (offset + trace_size > size)
+                        break;
+                    _offsets.push_back(offset);
+                    offset += trace_size;
+                }
+                _offsets.push_back(offset);
+            }
+        }
+
+        template <Endian ENDIANNESS_V>
+        static SegyTraceHeader _trace_header(const std::uint8_t* bytes)
+        {
+            SegyTraceHeader header;
+            header.trace_sequence_line = i32_IO::unpack<ENDIANNESS_V>(bytes);
+            header.trace_sequence_file = i32_IO::unpack<ENDIANNESS_V>(bytes + 4);
+            header.field_record = i32_IO::unpack<ENDIANNESS_V>(bytes + 8);
+            header.cdp = i32_IO::unpack<ENDIANNESS_V>(bytes + 20);
+            header.coordinate_scalar = i16_IO::unpack<ENDIANNESS_V>(bytes + 70);
+            header.source_x = i32_IO::unpack<ENDIANNESS_V>(bytes + 72);
+            header.source_y = i32_IO::unpack<ENDIANNESS_V>(bytes + 76);
+            header.n_samples = u16_IO::unpack<ENDIANNESS_V>(bytes + 114);
+            header.sample_interval = u16_IO::unpack<ENDIANNESS_V>(bytes + 116);
+            header.cdp_x = i32_IO::unpack<ENDIANNESS_V>(bytes + 180);
+            header.cdp_y = i32_IO::unpack<ENDIANNESS_V>(bytes + 184);
+            header.inline_number = i32_IO::unpack<ENDIANNESS_V>(bytes + 188);
+            header.crossline_number = i32_IO::unpack<ENDIANNESS_V>(bytes + 192);
+            return header;
+        }
+
+        template <Endian ENDIANNESS_V, typename IO_T>
+        static void _convert(const std::uint8_t* bytes, std::size_t count, float* out)
+        {
+            for (std::size_t i=0; i<count; i++)
+                out[i] = static_cast<float>(IO_T::template unpack<ENDIANNESS_V>(bytes + i * IO_T::N_IO_BYTES));
+        }
+
+        template <Endian ENDIANNESS_V>
+        void _decode(const std::uint8_t* bytes, std::size_t count, float* out) const
+        {
+            switch (_format)
+            {
+                case SegyFormat::IBM_FLOAT:
+                    for (std::size_t i=0; i<count; i++)
+                        out[i] = __ibm_to_float(u32_IO::unpack<ENDIANNESS_V>(bytes + i * 4));
+                    break;
+                case SegyFormat::IEEE_FLOAT:  _convert<ENDIANNESS_V, fp32_IO>(bytes, count, out); break;
+                case SegyFormat::IEEE_DOUBLE: _convert<ENDIANNESS_V, fp64_IO>(bytes, count, out); break;
+                case SegyFormat::INT8:        _convert<ENDIANNESS_V, i8_IO>(bytes, count, out);   break;
+                case SegyFormat::INT16:       _convert<ENDIANNESS_V, i16_IO>(bytes, count, out);  break;
+                case SegyFormat::INT24:       _convert<ENDIANNESS_V, i24_IO>(bytes, count, out);  break;
+                case SegyFormat::INT32:       _convert<ENDIANNESS_V, i32_IO>(bytes, count, out);  break;
+                case SegyFormat::INT64:       _convert<ENDIANNESS_V, i64_IO>(bytes, count, out);  break;
+                case SegyFormat::UINT8:       _convert<ENDIANNESS_V, u8_IO>(bytes, count, out);   break;
+                case SegyFormat::UINT16:      _convert<ENDIANNESS_V, u16_IO>(bytes, count, out);  break;
+                case SegyFormat::UINT24:      _convert<ENDIANNESS_V, u24_IO>(bytes, count, out);  break;
+                case SegyFormat::UINT32:      _convert<ENDIANNESS_V, u32_IO>(bytes, count, out);  break;
+                case SegyFormat::UINT64:      _convert<ENDIANNESS_V, u64_IO>(bytes, count, out);  break;
+            }
+        }
+
+        void _decode_traces(std::size_t first, std::size_t count, float* out) const
+        {
+            for (std::size_t trace=first; trace<first+count; trace++)
+            {
+                const std::size_t n = n_samples(trace);
+                const std::uint8_t* samples = _file.data() + _offsets[trace] + __SEGY_TRACE_HEADER_SIZE;
+                if (_endianness == Endian::LITTLE)
+                    _decode<Endian::LITTLE>(samples, n, out);
+                else
+                    _decode<Endian::BIG>(samples, n, out);
+                out += n;
+            }
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_SEGY_H */
@@ -0,0 +1,579 @@
+#ifndef NUMIO_SERIALIZE_H
+#define NUMIO_SERIALIZE_H
+
+// ****************************************************************************
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "../numio.hpp"
+#include "std.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    namespace {
+        ///
+        /// @brief Checks if a double is exactly representable in a smaller IEEE 754 binary format, by inspecting its
+        /// bits. Infinities and NaNs qualify if no payload bits would be lost.
+        ///
+        template <unsigned int N_BITS_EXPONENT, unsigned int N_BITS_FRACTION>
+        static bool __is_exact_in_float_format(double value)
+        {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            const int exponent_field = static_cast<int>((bits >> 52) & 0x7FF);
+            const std::uint64_t fraction = bits & 0x000FFFFFFFFFFFFFull;
+            constexpr unsigned int N_DROPPED_BITS = 52 - N_BITS_FRACTION;
+            constexpr std::uint64_t DROPPED_MASK = (static_cast<std::uint64_t>(1) << N_DROPPED_BITS) - 1;
+
+            if (exponent_field == 0x7FF)
+                return (fraction & DROPPED_MASK) == 0;
+            if (exponent_field == 0)
+                return fraction == 0;
+
+            constexpr int BIAS = (1 << (N_BITS_EXPONENT - 1)) - 1;
+            const int exponent = exponent_field - 1023;
+            if (exponent > BIAS)
+                return false;
+            if (exponent >= 1 - BIAS)
+                return (fraction & DROPPED_MASK) == 0;
+
+            // Subnormal in the target format: the significand including the implicit bit is shifted further right
+            const int n_extra_bits = (1 - BIAS) - exponent;
+            if (n_extra_bits > static_cast<int>(N_BITS_FRACTION))
+                return false;
+            const std::uint64_t significand = fraction | (static_cast<std::uint64_t>(1) << 52);
+            return (significand & ((static_cast<std::uint64_t>(1) << (N_DROPPED_BITS + n_extra_bits)) - 1)) == 0;
+        }
+
+        // Decoded number of either format
+        struct __SerialNumber
+        {
+            enum { UNSIGNED, NEGATIVE, FLOAT } kind;
+            std::uint64_t u;
+            std::int64_t i;
+            double f;
+        };
+
+        template <typename T>
+        static T __serial_number_to(const __SerialNumber& number)
+        {
+            if constexpr (std::is_floating_point_v<T>) {
+                switch (number.kind) {
+                    case __SerialNumber::UNSIGNED: return static_cast<T>(number.u);
+                    case __SerialNumber::NEGATIVE: return static_cast<T>(number.i);
+                    default:                       return static_cast<T>(number.f);
+                }
+            }
+            else {
+                if (number.kind == __SerialNumber::FLOAT)
+                    throw std::runtime_error("Number is not an integer!");
+                if (number.kind == __SerialNumber::UNSIGNED) {
+                    if (number.u > static_cast<std::uint64_t>(std::numeric_limits<T>::max()))
+                        throw std::runtime_error("Number does not fit in the requested type!");
+                    return static_cast<T>(number.u);
+                }
+                if (!std::is_signed_v<T> || number.i < static_cast<std::int64_t>(std::numeric_limits<T>::min()))
+                    throw std::runtime_error("Number does not fit in the requested type!");
+                return static_cast<T>(number.i);
+            }
+        }
+    }
+
+
+    ///
+    /// @brief Encoding and decoding of numbers as CBOR (RFC 8949) data items, using preferred serialization.
+    ///
+    /// Integers use the smallest argument size. Floats use the smallest of half, single and double precision that
+    /// represents the value exactly, which is determined from the bits of the value rather than by trial conversion.
+    ///
+    class Cbor
+    {
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        static std::size_t _encode_head(unsigned int major, std::uint64_t argument, std::uint8_t* out)
+        {
+            const std::uint8_t type = static_cast<std::uint8_t>(major << 5);
+            if (argument < 24) {
+                out[0] = static_cast<std::uint8_t>(type | argument);
+                return 1;
+            }
+            if (argument <= 0xFF) {
+                out[0] = type | 24;
+                u8_IO::pack(static_cast<std::uint8_t>(argument), out + 1);
+                return 2;
+            }
+            if (argument <= 0xFFFF) {
+                out[0] = type | 25;
+                u16_IO::pack<Endian::BIG>(static_cast<std::uint16_t>(argument), out + 1);
+                return 3;
+            }
+            if (argument <= 0xFFFFFFFF) {
+                out[0] = type | 26;
+                u32_IO::pack<Endian::BIG>(static_cast<std::uint32_t>(argument), out + 1);
+                return 5;
+            }
+            out[0] = type | 27;
+            u64_IO::pack<Endian::BIG>(argument, out + 1);
+            return 9;
+        }
+
+        static std::uint64_t _decode_argument(const std::uint8_t* bytes, std::size_t size, std::size_t& position)
+        {
+            const unsigned int info = bytes[position++] & 0x1F;
+            if (info < 24)
+                return info;
+            if (info > 27)
+                throw std::runtime_error("CBOR item has an unsupported argument!");
+            const std::size_t n_bytes = static_cast<std::size_t>(1) << (info - 24);
+            if (size - position < n_bytes)
+                throw std::runtime_error("CBOR item is truncated!");
+            std::uint64_t argument;
+            switch (info) {
+                case 24:  argument = bytes[position]; break;
+                case 25:  argument = u16_IO::unpack<Endian::BIG>(bytes + position); break;
+                case 26:  argument = u32_IO::unpack<Endian::BIG>(bytes + position); break;
+                default:  argument = u64_IO::unpack<Endian::BIG>(bytes + position); break;
+            }
+            position += n_bytes;
+            return argument;
+        }
+
+        static __SerialNumber _decode(const std::uint8_t* bytes, std::size_t size, std::size_t& position)
+        {
+            if (position >= size)
+                throw std::runtime_error("CBOR item is truncated!");
+            const unsigned int major = bytes[position] >> 5;
+            const unsigned int info = bytes[position] & 0x1F;
+            __SerialNumber number = {};
+
+            if (major == 7)
+            {
+                const std::size_t n_bytes = info == 25 ? 2 : info == 26 ? 4 : info == 27 ? 8 : 0;
+                if (!n_bytes)
+                    throw std::runtime_error("CBOR item is not a number!");
+                if (size - position - 1 < n_bytes)
+                    throw std::runtime_error("CBOR item is truncated!");
+                const std::uint8_t* value = bytes + position + 1;
+                number.kind = __SerialNumber::FLOAT;
+                number.f = n_bytes == 2 ? static_cast<double>(fp16_IO::unpack<Endian::BIG>(value))
+                         : n_bytes == 4 ? static_cast<double>(fp32_IO::unpack<Endian::BIG>(value))
+                         :                fp64_IO::unpack<Endian::BIG>(value);
+                position += 1 + n_bytes;
+                return number;
+            }
+            if (major > 1)
+                throw std::runtime_error("CBOR item is not a number!");
+
+            const std::uint64_t argument = _decode_argument(bytes, size, position);
+            if (major == 0) {
+                number.kind = __SerialNumber::UNSIGNED;
+                number.u = argument;
+            }
+            else {
+                if (argument > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+                    throw std::runtime_error("CBOR negative integer does not fit in 64 bits!");
+                number.kind = __SerialNumber::NEGATIVE;
+                number.i = -1 - static_cast<std::int64_t>(argument);
+            }
+            return number;
+        }
+
+
+        // :: PUBLIC ATTRIBUTES :: //
+        public:
+
+        ///
+        /// @brief Maximum amount of bytes of an encoded number.
+        ///
+        static constexpr std::size_t MAX_NUMBER_SIZE = 9;
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Encodes a number as a single data item.
+        ///
+        /// @param value Integer or float value.
+        /// @param out Pointer to write up to `MAX_NUMBER_SIZE` bytes to.
+        /// @return Amount of bytes written.
+        ///
+        template <typename T>
+        static std::size_t encode(T value, std::uint8_t* out)
+        {
+            static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Template parameter T must be a number type!");
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                const double d = static_cast<double>(value);
+                if (__is_exact_in_float_format<5, 10>(d)) {
+                    out[0] = 0xF9;
+                    fp16_IO::pack<Endian::BIG>(static_cast<float>(d), out + 1);
+                    return 3;
+                }
+                if (__is_exact_in_float_format<8, 23>(d)) {
+                    out[0] = 0xFA;
+                    fp32_IO::pack<Endian::BIG>(static_cast<float>(d), out + 1);
+                    return 5;
+                }
+                out[0] = 0xFB;
+                fp64_IO::pack<Endian::BIG>(d, out + 1);
+                return 9;
+            }
+            else
+            {
+                if constexpr (std::is_signed_v<T>) {
+                    if (value < 0)
+                        return _encode_head(1, static_cast<std::uint64_t>(-1 - static_cast<std::int64_t>(value)), out);
+                }
+                return _encode_head(0, static_cast<std::uint64_t>(value), out);
+            }
+        }
+
+        ///
+        /// @brief Appends a number as a single data item to a vector of bytes.
+        ///
+        template <typename T>
+        static void encode(T value, std::vector<std::uint8_t>& out)
+        {
+            const std::size_t offset = out.size();
+            out.resize(offset + MAX_NUMBER_SIZE);
+            out.resize(offset + encode(value, out.data() + offset));
+        }
+
+        ///
+        /// @brief Appends an array of numbers (an array head followed by the numbers) to a vector of bytes.
+        ///
+        template <typename T>
+        static void encode_array(const T* values, std::size_t count, std::vector<std::uint8_t>& out)
+        {
+            std::size_t position = out.size();
+            out.resize(position + MAX_NUMBER_SIZE + count * MAX_NUMBER_SIZE);
+            position += _encode_head(4, count, out.data() + position);
+            for (std::size_t i=0; i<count; i++)
+                position += encode(values[i], out.data() + position);
+            out.resize(position);
+        }
+
+        ///
+        /// @brief Decodes a number data item.
+        ///
+        /// @param bytes Pointer to the first byte of the item.
+        /// @param size Amount of bytes available.
+        /// @param n_read Optional pointer receiving the amount of bytes of the item.
+        /// @throws std::runtime_error If the item is not a number, is truncated, or doesn't fit in `T`.
+        ///
+        template <typename T>
+        static T decode(const std::uint8_t* bytes, std::size_t size, std::size_t* n_read=nullptr)
+        {
+            std::size_t position = 0;
+            T value = __serial_number_to<T>(_decode(bytes, size, position));
+            if (n_read)
+                *n_read = position;
+            return value;
+        }
+
+        ///
+        /// @brief Decodes an array of numbers.
+        ///
+        /// @param bytes Pointer to the first byte of the array head.
+        /// @param size Amount of bytes available.
+        /// @param out Vector receiving the numbers. Resized to the amount of numbers.
+        /// @return Amount of bytes of the array.
+        ///
+        template <typename T>
+        static std::size_t decode_array(const std::uint8_t* bytes, std::size_t size, std::vector<T>& out)
+        {
+            if (size == 0 || bytes[0] >> 5 != 4)
+                throw std::runtime_error("CBOR item is not an array!");
+            std::size_t position = 0;
+            const std::uint64_t count = _decode_argument(bytes, size, position);
+            // Every item takes at least one byte
+            if (count > size - position)
+                throw std::runtime_error("CBOR item is truncated!");
+            out.resize(static_cast<std::size_t>(count));
+            for (auto& value : out)
+                value = __serial_number_to<T>(_decode(bytes, size, position));
+            return position;
+        }
+    };
+
+
+    ///
+    /// @brief Encoding and decoding of numbers as MessagePack objects.
+    ///
+    /// Integers use the smallest format that fits (fixint, 8, 16, 32 or 64 bits). Floats use float 32 if it
+    /// represents the value exactly, which is determined from the bits of the value, and float 64 otherwise.
+    ///
+    class MsgPack
+    {
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        static std::size_t _encode_unsigned(std::uint64_t value, std::uint8_t* out)
+        {
+            if (value <= 0x7F) {
+                out[0] = static_cast<std::uint8_t>(value);
+                return 1;
+            }
+            if (value <= 0xFF) {
+                out[0] = 0xCC;
+                out[1] = static_cast<std::uint8_t>(value);
+                return 2;
+            }
+            if (value <= 0xFFFF) {
+                out[0] = 0xCD;
+                u16_IO::pack<Endian::BIG>(static_cast<std::uint16_t>(value), out + 1);
+                return 3;
+            }
+            if (value <= 0xFFFFFFFF) {
+                out[0] = 0xCE;
+                u32_IO::pack<Endian::BIG>(static_cast<std::uint32_t>(value), out + 1);
+                return 5;
+            }
+            out[0] = 0xCF;
+            u64_IO::pack<Endian::BIG>(value, out + 1);
+            return 9;
+        }
+
+        static std::size_t _encode_negative(std::int64_t value, std::uint8_t* out)
+        {
+            if (value >= -32) {
+                out[0] = static_cast<std::uint8_t>(value);
+                return 1;
+            }
+            if (value >= INT8_MIN) {
+                out[0] = 0xD0;
+                i8_IO::pack(static_cast<std::int8_t>(value), out + 1);
+                return 2;
+            }
+            if (value >= INT16_MIN) {
+                out[0] = 0xD1;
+                i16_IO::pack<Endian::BIG>(static_cast<std::int16_t>(value), out + 1);
+                return 3;
+            }
+            if (value >= INT32_MIN) {
+                out[0] = 0xD2;
+                i32_IO::pack<Endian::BIG>(static_cast<std::int32_t>(value), out + 1);
+                return 5;
+            }
+            out[0] = 0xD3;
+            i64_IO::pack<Endian::BIG>(value, out + 1);
+            return 9;
+        }
+
+        static __SerialNumber _decode(const std::uint8_t* bytes, std::size_t size, std::size_t& position)
+        {
+            if (position >= size)
+                throw std::runtime_error("MessagePack object is truncated!");
+            const std::uint8_t type = bytes[position++];
+            __SerialNumber number = {};
+
+            if (type <= 0x7F) {
+                number.kind = __SerialNumber::UNSIGNED;
+                number.u = type;
+                return number;
+            }
+            if (type >= 0xE0) {
+                number.kind = __SerialNumber::NEGATIVE;
+                number.i = static_cast<std::int8_t>(type);
+                return number;
+            }
+
+            std::size_t n_bytes;
+            switch (type) {
+                case 0xCC: case 0xD0:             n_bytes = 1; break;
+                case 0xCD: case 0xD1:             n_bytes = 2; break;
+                case 0xCE: case 0xD2: case 0xCA:  n_bytes = 4; break;
+                case 0xCF: case 0xD3: case 0xCB:  n_bytes = 8; break;
+                default: throw std::runtime_error("MessagePack object is not a number!");
+            }
+            if (size - position < n_bytes)
+                throw std::runtime_error("MessagePack object is truncated!");
+            const std::uint8_t* value = bytes + position;
+            position += n_bytes;
+
+            switch (type) {
+                case 0xCC: number.u = value[0]; break;
+                case 0xCD: number.u = u16_IO::unpack<Endian::BIG>(value); break;
+                case 0xCE: number.u = u32_IO::unpack<Endian::BIG>(value); break;
+                case 0xCF: number.u = u64_IO::unpack<Endian::BIG>(value); break;
+                case 0xD0: number.i = static_cast<std::int8_t>(value[0]); break;
+                case 0xD1: number.i = i16_IO::unpack<Endian::BIG>(value); break;
+                case 0xD2: number.i = i32_IO::unpack<Endian::BIG>(value); break;
+                case 0xD3: number.i = i64_IO::unpack<Endian::BIG>(value); break;
+                case 0xCA: number.f = fp32_IO::unpack<Endian::BIG>(value); break;
+                default:   number.f = fp64_IO::unpack<Endian::BIG>(value); break;
+            }
+
+            if (type == 0xCA || type == 0xCB)
+                number.kind = __SerialNumber::FLOAT;
+            else if (type <= 0xCF)
+                number.kind = __SerialNumber::UNSIGNED;
+            else if (number.i >= 0) {
+                // Signed formats may hold non-negative values as well
+                number.kind = __SerialNumber::UNSIGNED;
+                number.u = static_cast<std::uint64_t>(number.i);
+            }
+            else
+                number.kind = __SerialNumber::NEGATIVE;
+            return number;
+        }
+
+
+        // :: PUBLIC ATTRIBUTES :: //
+        public:
+
+        ///
+        /// @brief Maximum amount of bytes of an encoded number.
+        ///
+        static constexpr std::size_t MAX_NUMBER_SIZE = 9;
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Encodes a number as a single object.
+        ///
+        /// @param value Integer or float value.
+        /// @param out Pointer to write up to `MAX_NUMBER_SIZE` bytes to.
+        /// @return Amount of bytes written.
+        ///
+        template <typename T>
+        static std::size_t encode(T value, std::uint8_t* out)
+        {
+            static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Template parameter T must be a number type!");
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                const double d = static_cast<double>(value);
+                if (__is_exact_in_float_format<8, 23>(d)) {
+                    out[0] = 0xCA;
+                    fp32_IO::pack<Endian::BIG>(static_cast<float>(d), out + 1);
+                    return 5;
+                }
+                out[0] = 0xCB;
+                fp64_IO::pack<Endian::BIG>(d, out + 1);
+                return 9;
+            }
+            else
+            {
+                if constexpr (std::is_signed_v<T>) {
+                    if (value < 0)
+                        return _encode_negative(static_cast<std::int64_t>(value), out);
+                }
+                return _encode_unsigned(static_cast<std::uint64_t>(value), out);
+            }
+        }
+
+        ///
+        /// @brief Appends a number as a single object to a vector of bytes.
+        ///
+        template <typename T>
+        static void encode(T value, std::vector<std::uint8_t>& out)
+        {
+            const std::size_t offset = out.size();
+            out.resize(offset + MAX_NUMBER_SIZE);
+            out.resize(offset + encode(value, out.data() + offset));
+        }
+
+        ///
+        /// @brief Appends an array of numbers (an array header followed by the numbers) to a vector of bytes.
+        ///
+        /// @throws std::runtime_error If the array has more than 2^32 - 1 elements.
+        ///
+        template <typename T>
+        static void encode_array(const T* values, std::size_t count, std::vector<std::uint8_t>& out)
+        {
+            if (count > 0xFFFFFFFFu)
+                throw std::runtime_error("MessagePack arrays can't hold more than 2^32 - 1 elements!");
+            std::size_t position = out.size();
+            out.resize(position + 5 + count * MAX_NUMBER_SIZE);
+            std::uint8_t* head = out.data() + position;
+            if (count < 16) {
+                head[0] = static_cast<std::uint8_t>(0x90 | count);
+                position += 1;
+            }
+            else if (count <= 0xFFFF) {
+                head[0] = 0xDC;
+                u16_IO::pack<Endian::BIG>(static_cast<std::uint16_t>(count), head + 1);
+                position += 3;
+            }
+            else {
+                head[0] = 0xDD;
+                u32_IO::pack<Endian::BIG>(static_cast<std::uint32_t>(count), head + 1);
+                position += 5;
+            }
+            for (std::size_t i=0; i<count; i++)
+                position += encode(values[i], out.data() + position);
+            out.resize(position);
+        }
+
+        ///
+        /// @brief Decodes a number object.
+        ///
+        /// @param bytes Pointer to the first byte of the object.
+        /// @param size Amount of bytes available.
+        /// @param n_read Optional pointer receiving the amount of bytes of the object.
+        /// @throws std::runtime_error If the object is not a number, is truncated, or doesn't fit in `T`.
+        ///
+        template <typename T>
+        static T decode(const std::uint8_t* bytes, std::size_t size, std::size_t* n_read=nullptr)
+        {
+            std::size_t position = 0;
+            T value = __serial_number_to<T>(_decode(bytes, size, position));
+            if (n_read)
+                *n_read = position;
+            return value;
+        }
+
+        ///
+        /// @brief Decodes an array of numbers.
+        ///
+        /// @param bytes Pointer to the first byte of the array header.
+        /// @param size Amount of bytes available.
+        /// @param out Vector receiving the numbers. Resized to the amount of numbers.
+        /// @return Amount of bytes of the array.
+        ///
+        template <typename T>
+        static std::size_t decode_array(const std::uint8_t* bytes, std::size_t size, std::vector<T>& out)
+        {
+            if (size == 0)
+                throw std::runtime_error("MessagePack object is truncated!");
+            std::size_t position = 1;
+            std::size_t count;
+            if ((bytes[0] & 0xF0) == 0x90)
+                count = bytes[0] & 0x0F;
+            else if (bytes[0] == 0xDC && size >= 3) {
+                count = u16_IO::unpack<Endian::BIG>(bytes + 1);
+                position = 3;
+            }
+            else if (bytes[0] == 0xDD && size >= 5) {
+                count = u32_IO::unpack<Endian::BIG>(bytes + 1);
+                position = 5;
+            }
+            else
+                throw std::runtime_error("MessagePack object is not an array!");
+
+            // Every element takes at least one byte
+            if (count > size - position)
+                throw std::runtime_error("MessagePack object is truncated!");
+            out.resize(count);
+            for (auto& value : out)
+                value = __serial_number_to<T>(_decode(bytes, size, position));
+            return position;
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_SERIALIZE_H */
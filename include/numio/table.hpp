@@ -0,0 +1,237 @@
+#ifndef NUMIO_TABLE_H
+#define NUMIO_TABLE_H
+
+// ****************************************************************************
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "../numio.hpp"
+#include "fp_extra.hpp"
+#include "std.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    ///
+    /// @brief Method used to decode floats.
+    ///
+    enum class DecodeMethod
+    {
+        /// Compute the value from the sign, exponent and fraction bits.
+        ARITHMETIC,
+        /// Look the value up in a table holding every representable value.
+        TABLE,
+    };
+
+
+    ///
+    /// @brief Template class for decoding small float formats (at most 16 bits) with a single table lookup.
+    ///
+    /// The table holds the decoded value of every bit pattern and is generated at compile time from the float format,
+    /// so it decodes exactly like `FLOAT_IO_T`, including its denormal mode. A 16-bit format takes 256 KiB with
+    /// `float`, which does not fit in the L1 cache, so whether the lookup beats the arithmetic depends on the host and
+    /// the access pattern. `benchmark()` measures this, and `unpack_fastest()` uses whichever method won on the host.
+    /// Packing is forwarded to `FLOAT_IO_T`.
+    ///
+    /// @tparam FLOAT_IO_T `FloatIO` type of the float format, e.g. `NumIO::fp16_IO`.
+    ///
+    template <typename FLOAT_IO_T>
+    class TableFloatIO
+    {
+        // :: PRIVATE ATTRIBUTES & HELPER FUNCTIONS :: //
+        private:
+
+        using _FLOAT_T = typename FLOAT_IO_T::value_type;
+        using _BITS_IO_TYPE = typename FLOAT_IO_T::int_io_type;
+        using _BITS_T = typename _BITS_IO_TYPE::value_type;
+
+        static constexpr unsigned int _N_BITS = _BITS_IO_TYPE::N_VALUE_BITS;
+
+        static_assert(_N_BITS <= 16, "Table decoding is limited to float formats of at most 16 bits!");
+
+        static constexpr std::size_t _N_ENTRIES = static_cast<std::size_t>(1) << _N_BITS;
+
+        static constexpr std::array<_FLOAT_T, _N_ENTRIES> _generate()
+        {
+            std::array<_FLOAT_T, _N_ENTRIES> table{};
+            for (std::size_t i=0; i<_N_ENTRIES; i++)
+                table[i] = FLOAT_IO_T::decode(static_cast<_BITS_T>(i));
+            return table;
+        }
+
+
+        // :: PUBLIC ATTRIBUTES :: //
+        public:
+
+        ///
+        /// @brief The amount of bytes used for the packed value.
+        ///
+        static constexpr int N_IO_BYTES = FLOAT_IO_T::N_IO_BYTES;
+
+        ///
+        /// @brief Float container type.
+        ///
+        using value_type = _FLOAT_T;
+
+        ///
+        /// @brief Integer I/O type of the binary representation.
+        ///
+        using int_io_type = _BITS_IO_TYPE;
+
+        ///
+        /// @brief Decoded value of every bit pattern of the float format.
+        ///
+        static constexpr std::array<_FLOAT_T, _N_ENTRIES> TABLE = _generate();
+
+
+        // :: CONVERSION FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Decodes a float from its binary representation.
+        ///
+        /// @param binary_data Sign, exponent and fraction bits of the float format, as retrieved by the integer I/O.
+        /// @return Float value.
+        ///
+        static constexpr _FLOAT_T decode(_BITS_T binary_data)
+        { return TABLE[static_cast<std::size_t>(static_cast<std::make_unsigned_t<_BITS_T>>(binary_data)) & (_N_ENTRIES - 1)]; }
+
+        ///
+        /// @brief Unpacks a float from a buffer of bytes.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param bytes Pointer to the first byte of the packed data. At least `N_IO_BYTES` bytes must be readable.
+        /// @return Float value.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static constexpr _FLOAT_T unpack(const std::uint8_t* bytes)
+        { return decode(_BITS_IO_TYPE::template unpack<ENDIANNESS_V>(bytes)); }
+
+        ///
+        /// @brief Packs a float into a buffer of bytes, same as `FLOAT_IO_T::pack()`.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, OverflowPolicy POLICY_V=OverflowPolicy::THROW>
+        static constexpr void pack(_FLOAT_T value, std::uint8_t* bytes)
+        { FLOAT_IO_T::template pack<ENDIANNESS_V, POLICY_V>(value, bytes); }
+
+
+        // :: BATCH FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Unpacks consecutive floats from a buffer of bytes with table lookups. The buffer is not bounds
+        /// checked.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param bytes Pointer to the first byte of the packed data.
+        /// @param count Amount of values to unpack.
+        /// @param out Output buffer receiving `count` float values.
+        /// @param stride Distance in bytes between the starts of consecutive values. Defaults to `N_IO_BYTES`.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static void unpack(const std::uint8_t* bytes, std::size_t count, _FLOAT_T* out, std::size_t stride=N_IO_BYTES)
+        {
+            for (std::size_t i=0; i<count; i++)
+                out[i] = unpack<ENDIANNESS_V>(bytes + i * stride);
+        }
+
+        ///
+        /// @brief Unpacks consecutive floats from a buffer of bytes with the given decoding method. The results are
+        /// the same for both methods.
+        ///
+        /// @tparam ENDIANNESS_V Defines the endianness of the data to process.
+        /// @param method Decoding method.
+        /// @param bytes Pointer to the first byte of the packed data.
+        /// @param count Amount of values to unpack.
+        /// @param out Output buffer receiving `count` float values.
+        /// @param stride Distance in bytes between the starts of consecutive values. Defaults to `N_IO_BYTES`.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static void unpack(DecodeMethod method, const std::uint8_t* bytes, std::size_t count, _FLOAT_T* out,
+                           std::size_t stride=N_IO_BYTES)
+        {
+            if (method == DecodeMethod::TABLE)
+                unpack<ENDIANNESS_V>(bytes, count, out, stride);
+            else
+                FLOAT_IO_T::template unpack<ENDIANNESS_V>(bytes, count, out, stride);
+        }
+
+        ///
+        /// @brief Unpacks consecutive floats from a buffer of bytes with the method preferred on this host, see
+        /// `preferred_method()`.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V>
+        static void unpack_fastest(const std::uint8_t* bytes, std::size_t count, _FLOAT_T* out,
+                                   std::size_t stride=N_IO_BYTES)
+        { unpack<ENDIANNESS_V>(preferred_method(), bytes, count, out, stride); }
+
+        ///
+        /// @brief Packs consecutive floats into a buffer of bytes, same as `FLOAT_IO_T::pack()`.
+        ///
+        template <Endian ENDIANNESS_V=NUMIO_DEFAULT_ENDIAN_V, OverflowPolicy POLICY_V=OverflowPolicy::THROW>
+        static void pack(const _FLOAT_T* values, std::size_t count, std::uint8_t* bytes, std::size_t stride=N_IO_BYTES)
+        { FLOAT_IO_T::template pack<ENDIANNESS_V, POLICY_V>(values, count, bytes, stride); }
+
+
+        // :: HOST CALIBRATION :: //
+        public:
+
+        ///
+        /// @brief Times both decoding methods on random bit patterns and returns the faster one.
+        ///
+        /// @param count Amount of values decoded per round. Larger amounts give more stable timings.
+        /// @param n_rounds Amount of rounds per method, of which the fastest is compared.
+        /// @return The faster decoding method.
+        ///
+        static DecodeMethod benchmark(std::size_t count=1 << 16, unsigned int n_rounds=5)
+        {
+            std::vector<std::uint8_t> bytes(count * N_IO_BYTES);
+            for (std::size_t i=0; i<count; i++)
+                _BITS_IO_TYPE::pack(static_cast<_BITS_T>(__mix64(i) & (_N_ENTRIES - 1)), bytes.data() + i * N_IO_BYTES);
+            std::vector<_FLOAT_T> out(count);
+
+            // Keeps the decoded values observable, so the timed loops are not optimized away
+            volatile _FLOAT_T sink = 0;
+            auto time = [&](DecodeMethod method) {
+                auto best = std::chrono::steady_clock::duration::max();
+                for (unsigned int r=0; r<n_rounds; r++) {
+                    const auto start = std::chrono::steady_clock::now();
+                    unpack(method, bytes.data(), count, out.data());
+                    const auto elapsed = std::chrono::steady_clock::now() - start;
+                    sink = sink + (count ? out[r % count] : 0);
+                    if (elapsed < best)
+                        best = elapsed;
+                }
+                return best;
+            };
+
+            // Warm up the table, so its first touch is not counted against it
+            time(DecodeMethod::TABLE);
+            return time(DecodeMethod::TABLE) < time(DecodeMethod::ARITHMETIC)
+                ? DecodeMethod::TABLE
+                : DecodeMethod::ARITHMETIC;
+        }
+
+        ///
+        /// @brief Returns the faster decoding method on this host, measured by `benchmark()` on the first call.
+        ///
+        static DecodeMethod preferred_method()
+        {
+            static const DecodeMethod method = benchmark();
+            return method;
+        }
+    };
+
+
+    using fp16_table_IO = TableFloatIO<fp16_IO>;
+    using bfloat16_table_IO = TableFloatIO<bfloat16_IO>;
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_TABLE_H */
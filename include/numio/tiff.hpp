@@ -0,0 +1,423 @@
+#ifndef NUMIO_TIFF_H
+#define NUMIO_TIFF_H
+
+// ****************************************************************************
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../numio.hpp"
+#include "mmap.hpp"
+#include "std.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    namespace {
+        static constexpr std::size_t __TIFF_ENTRY_SIZE = 12;
+        static constexpr std::size_t __TIFF_MAX_IFDS = 1024;
+    }
+
+    ///
+    /// @brief Field types of TIFF IFD entries.
+    ///
+    enum class TiffType : std::uint16_t
+    {
+        BYTE      = 1,
+        ASCII     = 2,
+        SHORT     = 3,
+        LONG      = 4,
+        RATIONAL  = 5,
+        SBYTE     = 6,
+        UNDEFINED = 7,
+        SSHORT    = 8,
+        SLONG     = 9,
+        SRATIONAL = 10,
+        FLOAT     = 11,
+        DOUBLE    = 12,
+        IFD       = 13,
+    };
+
+    ///
+    /// @brief Well-known TIFF tags pointing to child IFDs.
+    ///
+    namespace TiffTag
+    {
+        static constexpr std::uint16_t SUB_IFDS = 330;
+        static constexpr std::uint16_t EXIF_IFD = 34665;
+        static constexpr std::uint16_t GPS_IFD = 34853;
+        static constexpr std::uint16_t INTEROPERABILITY_IFD = 40965;
+    }
+
+    ///
+    /// @brief Entry of a TIFF image file directory (IFD). Only the location of the value is stored; the value itself is
+    /// decoded on request by `TiffReader`.
+    ///
+    struct TiffEntry
+    {
+        /// Tag identifying the field.
+        std::uint16_t tag = 0;
+        /// Field type, see `TiffType`. Unknown types are kept as is.
+        std::uint16_t type = 0;
+        /// Amount of values.
+        std::uint32_t count = 0;
+        /// Offset of the value bytes in the file; points into the entry itself for values of 4 bytes or less.
+        std::uint32_t offset = 0;
+
+        ///
+        /// @brief Returns the size of a single value in bytes, or 0 for unknown types.
+        ///
+        std::size_t type_size() const
+        {
+            switch (static_cast<TiffType>(type)) {
+                case TiffType::BYTE: case TiffType::ASCII: case TiffType::SBYTE: case TiffType::UNDEFINED:
+                    return 1;
+                case TiffType::SHORT: case TiffType::SSHORT:
+                    return 2;
+                case TiffType::LONG: case TiffType::SLONG: case TiffType::FLOAT: case TiffType::IFD:
+                    return 4;
+                case TiffType::RATIONAL: case TiffType::SRATIONAL: case TiffType::DOUBLE:
+                    return 8;
+                default:
+                    return 0;
+            }
+        }
+
+        ///
+        /// @brief Returns the size of all values in bytes.
+        ///
+        std::size_t size() const
+        { return type_size() * count; }
+    };
+
+    ///
+    /// @brief Image file directory: a list of entries sorted by tag.
+    ///
+    struct TiffIfd
+    {
+        /// Offset of the IFD in the file.
+        std::uint32_t offset = 0;
+        /// Entries of the IFD, sorted by tag.
+        std::vector<TiffEntry> entries;
+
+        ///
+        /// @brief Returns the entry with a given tag, or a null pointer if not present.
+        ///
+        const TiffEntry* find(std::uint16_t tag) const
+        {
+            auto it = std::lower_bound(entries.begin(), entries.end(), tag,
+                                       [](const TiffEntry& entry, std::uint16_t t) { return entry.tag < t; });
+            return it != entries.end() && it->tag == tag ? &*it : nullptr;
+        }
+    };
+
+
+    ///
+    /// @brief Parser of TIFF structured data, such as TIFF and DNG files or EXIF metadata.
+    ///
+    /// The data is accessed in memory (memory mapped when opening a file), so no stream seeking is involved. The byte
+    /// order is detected once from the `II`/`MM` mark, after which the entries of an IFD are decoded with strided
+    /// batch unpacking in that byte order. Values are only decoded when requested.
+    ///
+    class TiffReader
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        MappedFile _file;
+        const std::uint8_t* _data;
+        std::size_t _size;
+        Endian _endianness;
+        std::vector<TiffIfd> _ifds;
+
+
+        // :: CONSTRUCTORS :: //
+        public:
+
+        ///
+        /// @brief Opens a TIFF file by memory mapping it, and parses the chain of main IFDs.
+        ///
+        /// @param path Path of the file to open.
+        /// @throws std::runtime_error If the file can't be mapped or is malformed.
+        ///
+        explicit TiffReader(const std::string& path)
+            : _file(path), _data(_file.data()), _size(_file.size())
+        { _parse(); }
+
+        ///
+        /// @brief Parses TIFF structured data in memory, e.g. the payload of an EXIF segment following `"Exif\0\0"`.
+        ///
+        /// @param data Pointer to the byte order mark. The data must outlive the reader.
+        /// @param size Size of the data in bytes.
+        /// @throws std::runtime_error If the data is malformed.
+        ///
+        TiffReader(const std::uint8_t* data, std::size_t size)
+            : _data(data), _size(size)
+        { _parse(); }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns the byte order of the data.
+        ///
+        Endian endianness() const
+        { return _endianness; }
+
+        ///
+        /// @brief Returns the chain of main IFDs; the first one describes the first image.
+        ///
+        const std::vector<TiffIfd>& ifds() const
+        { return _ifds; }
+
+        ///
+        /// @brief Parses the IFD at a given offset.
+        ///
+        /// @throws std::runtime_error If the IFD is out of bounds.
+        ///
+        TiffIfd read_ifd(std::uint32_t offset) const
+        {
+            return _endianness == Endian::LITTLE ? _read_ifd<Endian::LITTLE>(offset)
+                                                 : _read_ifd<Endian::BIG>(offset);
+        }
+
+        ///
+        /// @brief Parses the child IFDs an entry points to, e.g. `TiffTag::EXIF_IFD` or `TiffTag::SUB_IFDS`.
+        ///
+        std::vector<TiffIfd> child_ifds(const TiffEntry& entry) const
+        {
+            std::vector<std::uint32_t> offsets;
+            values(entry, offsets);
+            std::vector<TiffIfd> result;
+            result.reserve(offsets.size());
+            for (auto offset : offsets)
+                result.push_back(read_ifd(offset));
+            return result;
+        }
+
+        ///
+        /// @brief Returns a pointer to the raw value bytes of an entry.
+        ///
+        /// @throws std::runtime_error If the value is out of bounds.
+        ///
+        const std::uint8_t* data(const TiffEntry& entry) const
+        {
+            if (static_cast<std::uint64_t>(entry.offset) + entry.size() > _size)
+                throw std::runtime_error("TIFF entry value is out of bounds!");
+            return _data + entry.offset;
+        }
+
+        ///
+        /// @brief Decodes all values of a numeric entry.
+        ///
+        /// Rationals are divided, i.e. truncated when decoding into an integer type.
+        ///
+        /// @tparam T Arithmetic type to decode into.
+        /// @param entry Entry to decode.
+        /// @param out Vector receiving the values. Resized to the amount of values.
+        /// @throws std::runtime_error If the entry is not numeric or its value is out of bounds.
+        ///
+        template <typename T>
+        void values(const TiffEntry& entry, std::vector<T>& out) const
+        {
+            // Validated before resizing, as the count comes from the file
+            const std::uint8_t* bytes = _numeric_data(entry);
+            out.resize(entry.count);
+            if (_endianness == Endian::LITTLE)
+                _values<Endian::LITTLE>(entry.type, bytes, entry.count, out.data());
+            else
+                _values<Endian::BIG>(entry.type, bytes, entry.count, out.data());
+        }
+
+        ///
+        /// @brief Decodes a single value of a numeric entry.
+        ///
+        /// @tparam T Arithmetic type to decode into.
+        /// @param entry Entry to decode.
+        /// @param index Index of the value.
+        /// @throws std::runtime_error If the index is out of range, or the entry is not numeric or its value is out of
+        /// bounds.
+        ///
+        template <typename T>
+        T value(const TiffEntry& entry, std::size_t index=0) const
+        {
+            if (index >= entry.count)
+                throw std::runtime_error("TIFF entry value index is out of range!");
+            // The whole value is bounds checked, so the offset of the indexed value can't wrap
+            const std::uint8_t* bytes = _numeric_data(entry) + index * entry.type_size();
+            T result;
+            if (_endianness == Endian::LITTLE)
+                _values<Endian::LITTLE>(entry.type, bytes, 1, &result);
+            else
+                _values<Endian::BIG>(entry.type, bytes, 1, &result);
+            return result;
+        }
+
+        ///
+        /// @brief Returns the value of an ASCII entry, without the trailing null characters.
+        ///
+        std::string string(const TiffEntry& entry) const
+        {
+            const char* chars = reinterpret_cast<const char*>(data(entry));
+            std::size_t length = entry.size();
+            while (length && chars[length - 1] == '\0')
+                length--;
+            return std::string(chars, length);
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        void _parse()
+        {
+            if (_size < 8)
+                throw std::runtime_error("Data is not a TIFF file!");
+            if (_data[0] == 'I' && _data[1] == 'I')
+                _endianness = Endian::LITTLE;
+            else if (_data[0] == 'M' && _data[1] == 'M')
+                _endianness = Endian::BIG;
+            else
+                throw std::runtime_error("Data is not a TIFF file!");
+
+            if (_endianness == Endian::LITTLE)
+                _parse_chain<Endian::LITTLE>();
+            else
+                _parse_chain<Endian::BIG>();
+        }
+
+        template <Endian ENDIANNESS_V>
+        void _parse_chain()
+        {
+            if (u16_IO::unpack<ENDIANNESS_V>(_data + 2) != 42)
+                throw std::runtime_error("TIFF version is not supported!");
+
+            std::uint32_t offset = u32_IO::unpack<ENDIANNESS_V>(_data + 4);
+            while (offset)
+            {
+                // Guard against cyclic chains
+                if (_ifds.size() == __TIFF_MAX_IFDS)
+                    throw std::runtime_error("TIFF file has too many IFDs!");
+                for (const auto& ifd : _ifds) {
+                    if (ifd.offset == offset)
+                        throw std::runtime_error("TIFF file has a cyclic IFD chain!");
+                }
+
+                _ifds.push_back(_read_ifd<ENDIANNESS_V>(offset));
+                const std::size_t next = offset + 2 + _ifds.back().entries.size() * __TIFF_ENTRY_SIZE;
+                offset = next + 4 <= _size ? u32_IO::unpack<ENDIANNESS_V>(_data + next) : 0;
+            }
+        }
+
+        template <Endian ENDIANNESS_V>
+        TiffIfd _read_ifd(std::uint32_t offset) const
+        {
+            if (static_cast<std::uint64_t>(offset) + 2 > _size)
+                throw std::runtime_error("TIFF IFD is out of bounds!");
+            const std::size_t n_entries = u16_IO::unpack<ENDIANNESS_V>(_data + offset);
+            const std::size_t begin = offset + 2;
+            if (begin + n_entries * __TIFF_ENTRY_SIZE > _size)
+                throw std::runtime_error("TIFF IFD is out of bounds!");
+
+            // Decode each field of all entries at once, with the entry size as stride
+            const std::uint8_t* bytes = _data + begin;
+            std::vector<std::uint16_t> tags(n_entries), types(n_entries);
+            std::vector<std::uint32_t> counts(n_entries), offsets(n_entries);
+            u16_IO::unpack<ENDIANNESS_V>(bytes,     n_entries, tags.data(),    __TIFF_ENTRY_SIZE);
+            u16_IO::unpack<ENDIANNESS_V>(bytes + 2, n_entries, types.data(),   __TIFF_ENTRY_SIZE);
+            u32_IO::unpack<ENDIANNESS_V>(bytes + 4, n_entries, counts.data(),  __TIFF_ENTRY_SIZE);
+            u32_IO::unpack<ENDIANNESS_V>(bytes + 8, n_entries, offsets.data(), __TIFF_ENTRY_SIZE);
+
+            TiffIfd ifd;
+            ifd.offset = offset;
+            ifd.entries.resize(n_entries);
+            for (std::size_t i=0; i<n_entries; i++)
+            {
+                TiffEntry& entry = ifd.entries[i];
+                entry.tag = tags[i];
+                entry.type = types[i];
+                entry.count = counts[i];
+                // Values of up to 4 bytes are stored in the entry itself
+                entry.offset = static_cast<std::uint64_t>(entry.type_size()) * entry.count <= 4
+                    ? static_cast<std::uint32_t>(begin + i * __TIFF_ENTRY_SIZE + 8)
+                    : offsets[i];
+            }
+
+            // Writers are required to sort by tag, but not all do
+            if (!std::is_sorted(ifd.entries.begin(), ifd.entries.end(),
+                                [](const TiffEntry& a, const TiffEntry& b) { return a.tag < b.tag; }))
+                std::stable_sort(ifd.entries.begin(), ifd.entries.end(),
+                                 [](const TiffEntry& a, const TiffEntry& b) { return a.tag < b.tag; });
+            return ifd;
+        }
+
+        template <Endian ENDIANNESS_V, typename IO_T, typename T>
+        void _convert(const std::uint8_t* bytes, std::size_t count, T* out) const
+        {
+            for (std::size_t i=0; i<count; i++)
+                out[i] = static_cast<T>(IO_T::template unpack<ENDIANNESS_V>(bytes + i * IO_T::N_IO_BYTES));
+        }
+
+        template <Endian ENDIANNESS_V, typename IO_T, typename T>
+        void _convert_rational(const std::uint8_t* bytes, std::size_t count, T* out) const
+        {
+            using CALC_T = std::conditional_t<std::is_floating_point_v<T>, double, std::int64_t>;
+            for (std::size_t i=0; i<count; i++) {
+                CALC_T numerator = static_cast<CALC_T>(IO_T::template unpack<ENDIANNESS_V>(bytes + i * 8));
+                CALC_T denominator = static_cast<CALC_T>(IO_T::template unpack<ENDIANNESS_V>(bytes + i * 8 + 4));
+                if constexpr (std::is_floating_point_v<T>)
+                    out[i] = static_cast<T>(numerator / denominator);
+                else
+                    out[i] = static_cast<T>(denominator ? numerator / denominator : 0);
+            }
+        }
+
+        const std::uint8_t* _numeric_data(const TiffEntry& entry) const
+        {
+            if (entry.type_size() == 0 || static_cast<TiffType>(entry.type) == TiffType::ASCII)
+                throw std::runtime_error("TIFF entry is not numeric!");
+            return data(entry);
+        }
+
+        template <Endian ENDIANNESS_V, typename T>
+        void _values(std::uint16_t type, const std::uint8_t* bytes, std::size_t count, T* out) const
+        {
+            static_assert(std::is_arithmetic_v<T>, "Template parameter T must be an arithmetic type!");
+            switch (static_cast<TiffType>(type))
+            {
+                case TiffType::BYTE: case TiffType::UNDEFINED:
+                    _convert<ENDIANNESS_V, u8_IO>(bytes, count, out); break;
+                case TiffType::SBYTE:
+                    _convert<ENDIANNESS_V, i8_IO>(bytes, count, out); break;
+                case TiffType::SHORT:
+                    _convert<ENDIANNESS_V, u16_IO>(bytes, count, out); break;
+                case TiffType::SSHORT:
+                    _convert<ENDIANNESS_V, i16_IO>(bytes, count, out); break;
+                case TiffType::LONG: case TiffType::IFD:
+                    _convert<ENDIANNESS_V, u32_IO>(bytes, count, out); break;
+                case TiffType::SLONG:
+                    _convert<ENDIANNESS_V, i32_IO>(bytes, count, out); break;
+                case TiffType::FLOAT:
+                    _convert<ENDIANNESS_V, fp32_IO>(bytes, count, out); break;
+                case TiffType::DOUBLE:
+                    _convert<ENDIANNESS_V, fp64_IO>(bytes, count, out); break;
+                case TiffType::RATIONAL:
+                    _convert_rational<ENDIANNESS_V, u32_IO>(bytes, count, out); break;
+                case TiffType::SRATIONAL:
+                    _convert_rational<ENDIANNESS_V, i32_IO>(bytes, count, out); break;
+                default:
+                    throw std::runtime_error("TIFF entry is not numeric!");
+            }
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_TIFF_H */
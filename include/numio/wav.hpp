@@ -0,0 +1,611 @@
+#ifndef NUMIO_WAV_H
+#define NUMIO_WAV_H
+
+// ****************************************************************************
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../numio.hpp"
+#include "mmap.hpp"
+#include "pcm.hpp"
+#include "std.hpp"
+
+// ****************************************************************************
+
+namespace NumIO
+{
+    ///
+    /// @brief Sample encodings of WAV files.
+    ///
+    enum class WavEncoding
+    {
+        PCM   = 1,
+        FLOAT = 3,
+    };
+
+    ///
+    /// @brief Format of the sample data of a WAV file.
+    ///
+    struct WavFormat
+    {
+        /// Encoding of the samples. 8-bit PCM is unsigned, wider PCM is signed.
+        WavEncoding encoding = WavEncoding::PCM;
+        /// Amount of interleaved channels.
+        std::uint16_t n_channels = 2;
+        /// Amount of frames per second.
+        std::uint32_t sample_rate = 44100;
+        /// Amount of bits per sample. Either 8, 16, 24 or 32 for PCM, or 32 or 64 for float.
+        std::uint16_t bits_per_sample = 16;
+
+        ///
+        /// @brief Returns the amount of bytes of a single sample.
+        ///
+        std::uint16_t bytes_per_sample() const
+        { return static_cast<std::uint16_t>((bits_per_sample + 7) / 8); }
+
+        ///
+        /// @brief Returns the amount of bytes of a frame, which holds one sample of every channel.
+        ///
+        std::size_t block_align() const
+        { return static_cast<std::size_t>(n_channels) * bytes_per_sample(); }
+
+        ///
+        /// @brief Checks if the format is one of the supported sample formats, with a frame size that fits the 16-bit
+        /// block align field of the header.
+        ///
+        bool is_supported() const
+        {
+            if (n_channels == 0 || block_align() > 0xFFFF)
+                return false;
+            if (encoding == WavEncoding::PCM)
+                return bits_per_sample == 8 || bits_per_sample == 16 || bits_per_sample == 24 || bits_per_sample == 32;
+            return bits_per_sample == 32 || bits_per_sample == 64;
+        }
+    };
+
+    namespace {
+        static constexpr std::uint32_t __WAV_FOURCC(const char (&id)[5])
+        {
+            return static_cast<std::uint32_t>(static_cast<std::uint8_t>(id[0]))
+                 | static_cast<std::uint32_t>(static_cast<std::uint8_t>(id[1])) << 8
+                 | static_cast<std::uint32_t>(static_cast<std::uint8_t>(id[2])) << 16
+                 | static_cast<std::uint32_t>(static_cast<std::uint8_t>(id[3])) << 24;
+        }
+
+        static constexpr std::uint16_t __WAV_FORMAT_EXTENSIBLE = 0xFFFE;
+        static constexpr std::uint32_t __WAV_SIZE_UNKNOWN = 0xFFFFFFFF;
+        // Size of the ds64 chunk body without a chunk size table
+        static constexpr std::uint32_t __WAV_DS64_SIZE = 28;
+        // Upper limit of the fmt and ds64 chunk sizes, far above that of valid files
+        static constexpr std::uint32_t __WAV_MAX_HEADER_CHUNK_SIZE = 1 << 20;
+    }
+
+
+    ///
+    /// @brief Reader of WAV (RIFF) and RF64 files.
+    ///
+    /// Files are either memory mapped, in which case the sample data is decoded straight from the mapping, or read
+    /// from a stream in blocks. Samples are decoded per channel into separate buffers.
+    ///
+    class WavReader
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        MappedFile _file;
+        std::istream* _stream = nullptr;
+        std::size_t _cursor = 0;
+        std::vector<std::uint8_t> _buffer;
+
+        WavFormat _format;
+        std::size_t _data_offset = 0;
+        std::uint64_t _n_frames = 0;
+        std::uint64_t _position = 0;
+
+
+        // :: CONSTRUCTORS :: //
+        public:
+
+        ///
+        /// @brief Opens a WAV file by memory mapping it.
+        ///
+        /// @param path Path of the file to open.
+        /// @throws std::runtime_error If the file can't be mapped, is malformed or has an unsupported format.
+        ///
+        explicit WavReader(const std::string& path)
+            : _file(path)
+        { _parse_header(); }
+
+        ///
+        /// @brief Opens a WAV file from a binary stream. The stream is read up to the start of the sample data.
+        ///
+        /// @param s Binary stream to read from. Must outlive the reader.
+        /// @throws std::runtime_error If the data is malformed or has an unsupported format.
+        ///
+        explicit WavReader(std::istream& s)
+            : _stream(&s)
+        { _parse_header(); }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns the format of the sample data.
+        ///
+        const WavFormat& format() const
+        { return _format; }
+
+        ///
+        /// @brief Returns the total amount of frames.
+        ///
+        std::uint64_t n_frames() const
+        { return _n_frames; }
+
+        ///
+        /// @brief Returns the amount of frames read so far.
+        ///
+        std::uint64_t position() const
+        { return _position; }
+
+        ///
+        /// @brief Returns the raw interleaved sample data when memory mapped, otherwise `nullptr`.
+        ///
+        const std::uint8_t* data() const
+        { return _stream ? nullptr : _file.data() + _data_offset; }
+
+        ///
+        /// @brief Reads and decodes frames into a buffer per channel.
+        ///
+        /// Float buffers receive normalized values in the range of [-1, 1). Integer buffers receive the sample values
+        /// as stored, with 8-bit PCM centered around zero; float encoded files can't be read into integer buffers.
+        ///
+        /// @tparam T Type of the channel buffers, either a float type or `std::int32_t`.
+        /// @param channels Channel buffers, resized to the amount of channels and frames read.
+        /// @param n_frames Maximum amount of frames to read.
+        /// @return Amount of frames read.
+        ///
+        template <typename T>
+        std::size_t read(std::vector<std::vector<T>>& channels, std::size_t n_frames)
+        {
+            static_assert(std::is_floating_point_v<T> || std::is_same_v<T, std::int32_t>,
+                          "Channel buffers must be of a float type or std::int32_t!");
+            if constexpr (std::is_same_v<T, std::int32_t>) {
+                if (_format.encoding == WavEncoding::FLOAT)
+                    throw std::runtime_error("Float encoded WAV data can't be read into integer buffers!");
+            }
+
+            n_frames = static_cast<std::size_t>(std::min<std::uint64_t>(n_frames, _n_frames - _position));
+            const std::size_t block_align = _format.block_align();
+
+            const std::uint8_t* bytes;
+            if (_stream)
+            {
+                _buffer.resize(n_frames * block_align);
+                _stream->read(reinterpret_cast<char*>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+                n_frames = static_cast<std::size_t>(_stream->gcount()) / block_align;
+                bytes = _buffer.data();
+            }
+            else {
+                bytes = _file.data() + _data_offset + _position * block_align;
+            }
+
+            channels.resize(_format.n_channels);
+            for (std::size_t c=0; c<channels.size(); c++) {
+                channels[c].resize(n_frames);
+                _decode(bytes + c * _format.bytes_per_sample(), n_frames, block_align, channels[c].data());
+            }
+
+            _position += n_frames;
+            return n_frames;
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        bool _read_bytes(std::uint8_t* dst, std::size_t n)
+        {
+            if (_stream) {
+                _stream->read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(n));
+                return static_cast<std::size_t>(_stream->gcount()) == n;
+            }
+            if (_file.size() - _cursor < n)
+                return false;
+            std::memcpy(dst, _file.data() + _cursor, n);
+            _cursor += n;
+            return true;
+        }
+
+        void _skip(std::uint64_t n)
+        {
+            if (_stream) {
+                while (n) {
+                    auto step = std::min<std::uint64_t>(n, static_cast<std::uint64_t>(std::numeric_limits<std::streamsize>::max()));
+                    _stream->ignore(static_cast<std::streamsize>(step));
+                    n -= step;
+                }
+            }
+            else {
+                _cursor = static_cast<std::size_t>(std::min<std::uint64_t>(_cursor + n, _file.size()));
+            }
+        }
+
+        void _parse_header()
+        {
+            std::uint8_t header[12];
+            if (!_read_bytes(header, 12))
+                throw std::runtime_error("Data is too short to be a WAV file!");
+
+            const std::uint32_t riff_id = u32_IO::unpack<Endian::LITTLE>(header);
+            const bool is_rf64 = riff_id == __WAV_FOURCC("RF64");
+            if ((riff_id != __WAV_FOURCC("RIFF") && !is_rf64) || u32_IO::unpack<Endian::LITTLE>(header + 8) != __WAV_FOURCC("WAVE"))
+                throw std::runtime_error("Data is not a WAV file!");
+
+            std::uint64_t ds64_data_size = 0;
+            bool has_format = false;
+            std::vector<std::uint8_t> body;
+
+            for (;;)
+            {
+                std::uint8_t chunk_header[8];
+                if (!_read_bytes(chunk_header, 8))
+                    throw std::runtime_error("WAV file has no data chunk!");
+
+                const std::uint32_t chunk_id = u32_IO::unpack<Endian::LITTLE>(chunk_header);
+                std::uint64_t chunk_size = u32_IO::unpack<Endian::LITTLE>(chunk_header + 4);
+
+                if (chunk_id == __WAV_FOURCC("data"))
+                {
+                    if (!has_format)
+                        throw std::runtime_error("WAV file has no format chunk before its data chunk!");
+                    if (is_rf64 && chunk_size == __WAV_SIZE_UNKNOWN)
+                        chunk_size = ds64_data_size;
+                    if (!_stream) {
+                        _data_offset = _cursor;
+                        chunk_size = std::min<std::uint64_t>(chunk_size, _file.size() - _cursor);
+                    }
+                    _n_frames = chunk_size / _format.block_align();
+                    return;
+                }
+
+                if (chunk_id == __WAV_FOURCC("fmt ") || (chunk_id == __WAV_FOURCC("ds64") && is_rf64))
+                {
+                    // Check the size before allocating, as a corrupt size would allocate up to 4 GiB
+                    if (chunk_size > __WAV_MAX_HEADER_CHUNK_SIZE)
+                        throw std::runtime_error("WAV file has a malformed header chunk!");
+                    if (!_stream && chunk_size > _file.size() - _cursor)
+                        throw std::runtime_error("WAV file is truncated!");
+                    body.resize(static_cast<std::size_t>(chunk_size));
+                    if (!_read_bytes(body.data(), body.size()))
+                        throw std::runtime_error("WAV file is truncated!");
+                    if (chunk_size & 1)
+                        _skip(1);
+
+                    if (chunk_id == __WAV_FOURCC("ds64")) {
+                        if (chunk_size < __WAV_DS64_SIZE)
+                            throw std::runtime_error("WAV file has a malformed ds64 chunk!");
+                        ds64_data_size = u64_IO::unpack<Endian::LITTLE>(body.data() + 8);
+                    }
+                    else {
+                        _parse_format(body);
+                        has_format = true;
+                    }
+                }
+                else {
+                    // Chunks are padded to an even size
+                    _skip(chunk_size + (chunk_size & 1));
+                }
+            }
+        }
+
+        void _parse_format(const std::vector<std::uint8_t>& body)
+        {
+            if (body.size() < 16)
+                throw std::runtime_error("WAV file has a malformed format chunk!");
+
+            std::uint16_t format_tag = u16_IO::unpack<Endian::LITTLE>(body.data());
+            if (format_tag == __WAV_FORMAT_EXTENSIBLE) {
+                if (body.size() < 40)
+                    throw std::runtime_error("WAV file has a malformed extensible format chunk!");
+                // First two bytes of the sub format GUID hold the actual format tag
+                format_tag = u16_IO::unpack<Endian::LITTLE>(body.data() + 24);
+            }
+
+            _format.encoding = static_cast<WavEncoding>(format_tag);
+            _format.n_channels = u16_IO::unpack<Endian::LITTLE>(body.data() + 2);
+            _format.sample_rate = u32_IO::unpack<Endian::LITTLE>(body.data() + 4);
+            _format.bits_per_sample = u16_IO::unpack<Endian::LITTLE>(body.data() + 14);
+
+            if ((format_tag != static_cast<std::uint16_t>(WavEncoding::PCM) &&
+                 format_tag != static_cast<std::uint16_t>(WavEncoding::FLOAT)) || !_format.is_supported())
+                throw std::runtime_error("WAV file has an unsupported sample format!");
+            // Samples are located by the frame size, so the stored one must agree with the format
+            if (u16_IO::unpack<Endian::LITTLE>(body.data() + 12) != _format.block_align())
+                throw std::runtime_error("WAV file has a malformed format chunk!");
+        }
+
+        template <typename IO_T, typename T>
+        static void _decode_as(const std::uint8_t* bytes, std::size_t count, std::size_t stride, T* out)
+        {
+            for (std::size_t i=0; i<count; i++)
+                out[i] = static_cast<T>(IO_T::template unpack<Endian::LITTLE>(bytes + i * stride));
+        }
+
+        template <typename T>
+        void _decode(const std::uint8_t* bytes, std::size_t count, std::size_t stride, T* out) const
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                if (_format.encoding == WavEncoding::FLOAT) {
+                    if (_format.bits_per_sample == 32)
+                        _decode_as<fp32_IO>(bytes, count, stride, out);
+                    else
+                        _decode_as<fp64_IO>(bytes, count, stride, out);
+                    return;
+                }
+                switch (_format.bits_per_sample) {
+                    case  8: PcmIO< u8_IO>::unpack<Endian::LITTLE>(bytes, count, out, stride); break;
+                    case 16: PcmIO<i16_IO>::unpack<Endian::LITTLE>(bytes, count, out, stride); break;
+                    case 24: PcmIO<i24_IO>::unpack<Endian::LITTLE>(bytes, count, out, stride); break;
+                    case 32: PcmIO<i32_IO>::unpack<Endian::LITTLE>(bytes, count, out, stride); break;
+                }
+            }
+            else
+            {
+                switch (_format.bits_per_sample) {
+                    case  8:
+                        for (std::size_t i=0; i<count; i++)
+                            out[i] = static_cast<T>(u8_IO::unpack<Endian::LITTLE>(bytes + i * stride)) - 0x80;
+                        break;
+                    case 16: _decode_as<i16_IO>(bytes, count, stride, out); break;
+                    case 24: _decode_as<i24_IO>(bytes, count, stride, out); break;
+                    case 32: _decode_as<i32_IO>(bytes, count, stride, out); break;
+                }
+            }
+        }
+    };
+
+
+    ///
+    /// @brief Writer of WAV (RIFF) files to a binary stream, switching to RF64 when the data exceeds 4 GiB.
+    ///
+    /// Space for the RF64 size chunk is reserved in the header with a `JUNK` chunk. The stream must be seekable, since
+    /// the chunk sizes are written when finalizing.
+    ///
+    class WavWriter
+    {
+        // :: PRIVATE ATTRIBUTES :: //
+        private:
+
+        std::ostream* _stream;
+        std::streampos _start;
+        WavFormat _format;
+        std::uint64_t _n_frames = 0;
+        bool _finalized = false;
+        std::vector<std::uint8_t> _buffer;
+
+        // Offsets relative to the start of the file
+        static constexpr std::uint32_t _JUNK_OFFSET = 12;
+        static constexpr std::uint32_t _FORMAT_OFFSET = _JUNK_OFFSET + 8 + __WAV_DS64_SIZE;
+        static constexpr std::uint32_t _FORMAT_SIZE = 16;
+        static constexpr std::uint32_t _DATA_OFFSET = _FORMAT_OFFSET + 8 + _FORMAT_SIZE;
+
+
+        // :: CONSTRUCTORS & DESTRUCTOR :: //
+        public:
+
+        ///
+        /// @brief Starts writing a WAV file by writing its header.
+        ///
+        /// @param s Seekable binary stream to write to. Must outlive the writer.
+        /// @param format Format of the sample data.
+        /// @throws std::runtime_error If the format is not supported.
+        ///
+        WavWriter(std::ostream& s, const WavFormat& format)
+            : _stream(&s), _start(s.tellp()), _format(format)
+        {
+            if (!_format.is_supported())
+                throw std::runtime_error("Unsupported WAV sample format!");
+
+            std::vector<std::uint8_t> header;
+            header.reserve(_DATA_OFFSET + 8);
+            u32_IO::pack<Endian::LITTLE>(__WAV_FOURCC("RIFF"), header);
+            u32_IO::pack<Endian::LITTLE>(0, header);
+            u32_IO::pack<Endian::LITTLE>(__WAV_FOURCC("WAVE"), header);
+
+            u32_IO::pack<Endian::LITTLE>(__WAV_FOURCC("JUNK"), header);
+            u32_IO::pack<Endian::LITTLE>(__WAV_DS64_SIZE, header);
+            header.resize(header.size() + __WAV_DS64_SIZE, 0);
+
+            u32_IO::pack<Endian::LITTLE>(__WAV_FOURCC("fmt "), header);
+            u32_IO::pack<Endian::LITTLE>(_FORMAT_SIZE, header);
+            u16_IO::pack<Endian::LITTLE>(static_cast<std::uint16_t>(_format.encoding), header);
+            u16_IO::pack<Endian::LITTLE>(_format.n_channels, header);
+            u32_IO::pack<Endian::LITTLE>(_format.sample_rate, header);
+            u32_IO::pack<Endian::LITTLE>(static_cast<std::uint32_t>(_format.sample_rate * _format.block_align()), header);
+            u16_IO::pack<Endian::LITTLE>(static_cast<std::uint16_t>(_format.block_align()), header);
+            u16_IO::pack<Endian::LITTLE>(_format.bits_per_sample, header);
+
+            u32_IO::pack<Endian::LITTLE>(__WAV_FOURCC("data"), header);
+            u32_IO::pack<Endian::LITTLE>(0, header);
+
+            _stream->write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+        }
+
+        WavWriter(const WavWriter&) = delete;
+        WavWriter& operator=(const WavWriter&) = delete;
+
+        ~WavWriter()
+        {
+            try {
+                finalize();
+            }
+            catch (...) {
+            }
+        }
+
+
+        // :: PUBLIC FUNCTIONS :: //
+        public:
+
+        ///
+        /// @brief Returns the amount of frames written so far.
+        ///
+        std::uint64_t n_frames() const
+        { return _n_frames; }
+
+        ///
+        /// @brief Encodes and writes frames from a buffer per channel.
+        ///
+        /// Float buffers hold normalized values in the range of [-1, 1), which are rounded and clipped for PCM.
+        /// Integer buffers hold the sample values as stored, with 8-bit PCM centered around zero; integer buffers
+        /// can't be written to float encoded files.
+        ///
+        /// @tparam T Type of the channel buffers, either a float type or `std::int32_t`.
+        /// @param channels Channel buffers. Must hold one buffer per channel, each of the same length.
+        ///
+        template <typename T>
+        void write(const std::vector<std::vector<T>>& channels)
+        {
+            static_assert(std::is_floating_point_v<T> || std::is_same_v<T, std::int32_t>,
+                          "Channel buffers must be of a float type or std::int32_t!");
+            if constexpr (std::is_same_v<T, std::int32_t>) {
+                if (_format.encoding == WavEncoding::FLOAT)
+                    throw std::runtime_error("Integer buffers can't be written to float encoded WAV data!");
+            }
+            if (_finalized)
+                throw std::runtime_error("WAV file is already finalized!");
+            if (channels.size() != _format.n_channels)
+                throw std::runtime_error("Amount of channel buffers does not match the amount of channels!");
+
+            const std::size_t n_frames = channels.empty() ? 0 : channels[0].size();
+            for (auto& channel : channels) {
+                if (channel.size() != n_frames)
+                    throw std::runtime_error("Channel buffers differ in length!");
+            }
+
+            const std::size_t block_align = _format.block_align();
+            _buffer.resize(n_frames * block_align);
+            for (std::size_t c=0; c<channels.size(); c++)
+                _encode(channels[c].data(), n_frames, block_align, _buffer.data() + c * _format.bytes_per_sample());
+
+            _stream->write(reinterpret_cast<const char*>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+            _n_frames += n_frames;
+        }
+
+        ///
+        /// @brief Writes the chunk sizes into the header. Called automatically on destruction.
+        ///
+        void finalize()
+        {
+            if (_finalized)
+                return;
+            _finalized = true;
+
+            const std::uint64_t data_size = _n_frames * _format.block_align();
+            if (data_size & 1)
+                _stream->put(0);
+            const std::streampos end = _stream->tellp();
+
+            // The RIFF size counts everything after the RIFF chunk header, i.e. the data chunk header included
+            const std::uint64_t riff_size = _DATA_OFFSET + 8 + data_size + (data_size & 1) - 8;
+            std::vector<std::uint8_t> bytes;
+
+            if (riff_size > __WAV_SIZE_UNKNOWN)
+            {
+                u32_IO::pack<Endian::LITTLE>(__WAV_FOURCC("RF64"), bytes);
+                u32_IO::pack<Endian::LITTLE>(__WAV_SIZE_UNKNOWN, bytes);
+                _write_at(0, bytes);
+
+                // Turn the reserved junk chunk into the ds64 chunk
+                bytes.clear();
+                u32_IO::pack<Endian::LITTLE>(__WAV_FOURCC("ds64"), bytes);
+                u32_IO::pack<Endian::LITTLE>(__WAV_DS64_SIZE, bytes);
+                u64_IO::pack<Endian::LITTLE>(riff_size, bytes);
+                u64_IO::pack<Endian::LITTLE>(data_size, bytes);
+                u64_IO::pack<Endian::LITTLE>(_n_frames, bytes);
+                u32_IO::pack<Endian::LITTLE>(0, bytes);
+                _write_at(_JUNK_OFFSET, bytes);
+
+                bytes.clear();
+                u32_IO::pack<Endian::LITTLE>(__WAV_SIZE_UNKNOWN, bytes);
+                _write_at(_DATA_OFFSET + 4, bytes);
+            }
+            else
+            {
+                u32_IO::pack<Endian::LITTLE>(static_cast<std::uint32_t>(riff_size), bytes);
+                _write_at(4, bytes);
+
+                bytes.clear();
+                u32_IO::pack<Endian::LITTLE>(static_cast<std::uint32_t>(data_size), bytes);
+                _write_at(_DATA_OFFSET + 4, bytes);
+            }
+
+            _stream->seekp(end);
+            _stream->flush();
+        }
+
+
+        // :: PRIVATE HELPER FUNCTIONS :: //
+        private:
+
+        void _write_at(std::uint32_t offset, const std::vector<std::uint8_t>& bytes)
+        {
+            _stream->seekp(_start + static_cast<std::streamoff>(offset));
+            _stream->write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        template <typename IO_T, typename T>
+        static void _encode_as(const T* values, std::size_t count, std::size_t stride, std::uint8_t* bytes)
+        {
+            for (std::size_t i=0; i<count; i++)
+                IO_T::template pack<Endian::LITTLE>(static_cast<typename IO_T::value_type>(values[i]), bytes + i * stride);
+        }
+
+        template <typename T>
+        void _encode(const T* values, std::size_t count, std::size_t stride, std::uint8_t* bytes) const
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                if (_format.encoding == WavEncoding::FLOAT) {
+                    if (_format.bits_per_sample == 32)
+                        _encode_as<fp32_IO>(values, count, stride, bytes);
+                    else
+                        _encode_as<fp64_IO>(values, count, stride, bytes);
+                    return;
+                }
+                switch (_format.bits_per_sample) {
+                    case  8: PcmIO< u8_IO>::pack<Endian::LITTLE>(values, count, bytes, stride); break;
+                    case 16: PcmIO<i16_IO>::pack<Endian::LITTLE>(values, count, bytes, stride); break;
+                    case 24: PcmIO<i24_IO>::pack<Endian::LITTLE>(values, count, bytes, stride); break;
+                    case 32: PcmIO<i32_IO>::pack<Endian::LITTLE>(values, count, bytes, stride); break;
+                }
+            }
+            else
+            {
+                switch (_format.bits_per_sample) {
+                    case  8:
+                        for (std::size_t i=0; i<count; i++)
+                            u8_IO::pack<Endian::LITTLE>(static_cast<std::uint8_t>(values[i] + 0x80), bytes + i * stride);
+                        break;
+                    case 16: _encode_as<i16_IO>(values, count, stride, bytes); break;
+                    case 24: _encode_as<i24_IO>(values, count, stride, bytes); break;
+                    case 32: _encode_as<i32_IO>(values, count, stride, bytes); break;
+                }
+            }
+        }
+    };
+}
+
+// ****************************************************************************
+
+#endif /* NUMIO_WAV_H */
@@ -3,13 +3,39 @@
 
 // ****************************************************************************
 
+#include <algorithm>
+#include <array>
 #include <bitset>
 #include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
 #include <sstream>
+#include <vector>
 
 #include "../include/numio/native.hpp"
+#include "../include/numio/arrow.hpp"
+#include "../include/numio/chunked.hpp"
+#include "../include/numio/fits.hpp"
+#include "../include/numio/key.hpp"
+#include "../include/numio/pcap.hpp"
+#include "../include/numio/pcm.hpp"
+#include "../include/numio/pool.hpp"
+#include "../include/numio/npy.hpp"
+#include "../include/numio/radix_sort.hpp"
+#include "../include/numio/requantize.hpp"
+#include "../include/numio/search.hpp"
+#include "../include/numio/segy.hpp"
+#include "../include/numio/serialize.hpp"
+#include "../include/numio/table.hpp"
+#include "../include/numio/tiff.hpp"
+#include "../include/numio/wav.hpp"
 using namespace NumIO;
 
 // ****************************************************************************
@@ -657,6 +683,1587 @@ int main()
         }
     }
 
+    // Gather/scatter
+    {
+        using i24_IO = IntIO<std::int32_t, 24, false>;
+        using u13a_IO = IntIO<std::uint32_t, 13, true>;
+        using f32_IO = FloatIO<float, std::uint32_t>;
+
+        std::vector<std::int32_t> values;
+        std::vector<std::uint32_t> indices;
+        for (std::int32_t i=0; i<100; i++) {
+            values.push_back((i * 104729) % 8388608 - 4194304);
+            indices.push_back((i * 37) % 100);
+        }
+
+        // Little endian 24-bit non-aligned integer
+        {
+            std::vector<std::uint8_t> bytes(100 * i24_IO::N_IO_BYTES);
+            i24_IO::scatter_pack<Endian::LITTLE>(values, indices, bytes);
+
+            std::vector<std::int32_t> result;
+            i24_IO::gather_unpack<Endian::LITTLE>(bytes, indices, result);
+            assert(result == values);
+            for (std::size_t i=0; i<indices.size(); i++)
+                assert(i24_IO::unpack<Endian::LITTLE>(bytes, indices[i] * i24_IO::N_IO_BYTES) == values[i]);
+        }
+
+        // Big endian 24-bit non-aligned integer, 64-bit indices
+        {
+            std::vector<std::size_t> wide_indices(indices.begin(), indices.end());
+            std::vector<std::uint8_t> bytes(100 * i24_IO::N_IO_BYTES);
+            i24_IO::scatter_pack<Endian::BIG>(values, wide_indices, bytes);
+
+            std::vector<std::int32_t> result;
+            i24_IO::gather_unpack<Endian::BIG>(bytes, wide_indices, result);
+            assert(result == values);
+        }
+
+        // Big endian 13-bit aligned unsigned integer
+        {
+            std::vector<std::uint32_t> u_values;
+            for (auto value : values)
+                u_values.push_back(static_cast<std::uint32_t>(value) & 0x1FFF);
+
+            std::vector<std::uint8_t> bytes(100 * u13a_IO::N_IO_BYTES, 0xFF);
+            u13a_IO::scatter_pack<Endian::BIG>(u_values, indices, bytes);
+
+            std::vector<std::uint32_t> result;
+            u13a_IO::gather_unpack<Endian::BIG>(bytes, indices, result);
+            assert(result == u_values);
+        }
+
+        // Float
+        {
+            std::vector<float> f_values;
+            for (auto value : values)
+                f_values.push_back(value / 1024.0f);
+
+            std::vector<std::uint8_t> bytes(100 * f32_IO::N_IO_BYTES);
+            f32_IO::scatter_pack<Endian::BIG>(f_values, indices, bytes);
+
+            std::vector<float> result;
+            f32_IO::gather_unpack<Endian::BIG>(bytes, indices, result);
+            assert(result == f_values);
+        }
+    }
+
+    // PCM conversion
+    {
+        using i16_IO = IntIO<std::int16_t>;
+        using i24_IO = IntIO<std::int32_t, 24, false>;
+        using u8_IO = IntIO<std::uint8_t>;
+
+        // Little endian 16-bit, clipping
+        {
+            std::vector<float> values = {-1.0f, 0.0f, 0.5f, 2.0f, -2.0f, 32767.0f / 32768.0f};
+            std::vector<std::uint8_t> bytes;
+            PcmIO<i16_IO>::pack<Endian::LITTLE>(values, bytes);
+            assert(bytes.size() == 12);
+            assert(i16_IO::unpack<Endian::LITTLE>(bytes, 0) == -32768);
+            assert(i16_IO::unpack<Endian::LITTLE>(bytes, 4) == 16384);
+            assert(i16_IO::unpack<Endian::LITTLE>(bytes, 6) == 32767);
+            assert(i16_IO::unpack<Endian::LITTLE>(bytes, 8) == -32768);
+
+            std::vector<float> result;
+            PcmIO<i16_IO>::unpack<Endian::LITTLE>(bytes, result);
+            assert(result[0] == -1.0f && result[1] == 0.0f && result[2] == 0.5f && result[5] == values[5]);
+        }
+
+        // Unsigned 8-bit
+        {
+            std::vector<std::uint8_t> bytes = {0x00, 0x80, 0xFF};
+            std::vector<double> result;
+            PcmIO<u8_IO>::unpack(bytes, result);
+            assert(result[0] == -1.0 && result[1] == 0.0 && result[2] == 127.0 / 128.0);
+
+            std::vector<std::uint8_t> packed;
+            PcmIO<u8_IO>::pack(result, packed);
+            assert(packed == bytes);
+        }
+
+        // Big endian 24-bit with dither
+        {
+            std::vector<double> values;
+            for (int i=0; i<1000; i++)
+                values.push_back(std::sin(i * 0.01) * 0.9);
+
+            TpdfDither dither(1234);
+            std::vector<std::uint8_t> bytes;
+            PcmIO<i24_IO>::pack<Endian::BIG>(values, bytes, dither);
+
+            std::vector<double> result;
+            PcmIO<i24_IO>::unpack<Endian::BIG>(bytes, result);
+            for (std::size_t i=0; i<values.size(); i++)
+                assert(std::abs(result[i] - values[i]) <= 1.5 / 8388608.0);
+        }
+    }
+
+    // Requantization
+    {
+        using i16_IO = IntIO<std::int16_t>;
+        using i24_IO = IntIO<std::int32_t, 24, false>;
+        using u8_IO = IntIO<std::uint8_t>;
+
+        std::vector<std::int32_t> values = {0x7FFFFF, 0x12380, 0x1237F, -0x12380, -0x800000, -1};
+        std::vector<std::uint8_t> bytes;
+        for (auto value : values)
+            i24_IO::pack<Endian::LITTLE>(value, bytes);
+
+        // Narrowing, rounding and clipping
+        {
+            Requantizer<i24_IO, i16_IO> requantizer(Requantization::ROUND);
+            std::vector<std::uint8_t> result;
+            requantizer.process<Endian::LITTLE, Endian::BIG>(bytes, result);
+            assert(result.size() == values.size() * 2);
+            assert(i16_IO::unpack<Endian::BIG>(result, 0) == 0x7FFF);
+            assert(i16_IO::unpack<Endian::BIG>(result, 2) == 0x124);
+            assert(i16_IO::unpack<Endian::BIG>(result, 4) == 0x123);
+            assert(i16_IO::unpack<Endian::BIG>(result, 6) == -0x123);
+            assert(i16_IO::unpack<Endian::BIG>(result, 8) == -0x8000);
+            assert(i16_IO::unpack<Endian::BIG>(result, 10) == 0);
+        }
+
+        // Narrowing, truncating into unsigned
+        {
+            Requantizer<i24_IO, u8_IO> requantizer(Requantization::TRUNCATE);
+            std::vector<std::uint8_t> result;
+            requantizer.process(bytes, result);
+            assert((result == std::vector<std::uint8_t>{0xFF, 0x81, 0x81, 0x7E, 0x00, 0x7F}));
+        }
+
+        // Widening
+        {
+            std::vector<std::uint8_t> narrow = {0x34, 0x12, 0x00, 0x80};
+            Requantizer<i16_IO, i24_IO> requantizer;
+            std::vector<std::uint8_t> result;
+            requantizer.process(narrow, result);
+            assert(i24_IO::unpack(result, 0) == 0x123400);
+            assert(i24_IO::unpack(result, 3) == -0x800000);
+        }
+
+        // Dithering and noise shaping stay within a few LSB
+        for (auto method : {Requantization::DITHER, Requantization::NOISE_SHAPE})
+        {
+            std::vector<std::uint8_t> ramp;
+            for (std::int32_t i=0; i<4096; i++)
+                i24_IO::pack(i * 1021 - 2000000, ramp);
+
+            Requantizer<i24_IO, i16_IO> requantizer(method, 2);
+            std::vector<std::uint8_t> result;
+            requantizer.process(ramp, result);
+            for (std::int32_t i=0; i<4096; i++)
+                assert(std::abs(i16_IO::unpack(result, i * 2) * 256 - (i * 1021 - 2000000)) <= 3 * 256);
+        }
+
+        // Noise shaping in blocks that split frames gives the same output as a single call
+        {
+            std::vector<std::uint8_t> frames;
+            for (std::int32_t i=0; i<3000; i++)
+                i24_IO::pack((i % 3) * 2000000 - 2000000 + i * 77, frames);
+
+            Requantizer<i24_IO, i16_IO> whole(Requantization::NOISE_SHAPE, 3);
+            std::vector<std::uint8_t> expected(3000 * 2);
+            whole.process(frames.data(), 3000, expected.data());
+
+            Requantizer<i24_IO, i16_IO> split(Requantization::NOISE_SHAPE, 3);
+            std::vector<std::uint8_t> result(3000 * 2);
+            split.process(frames.data(), 1000, result.data());
+            split.process(frames.data() + 1000 * 3, 1001, result.data() + 1000 * 2);
+            split.process(frames.data() + 2001 * 3, 999, result.data() + 2001 * 2);
+            assert(result == expected);
+        }
+    }
+
+    // WAV
+    {
+        std::vector<std::vector<float>> channels(2);
+        for (int i=0; i<1001; i++) {
+            channels[0].push_back(static_cast<float>(std::sin(i * 0.05) * 0.8));
+            channels[1].push_back(static_cast<float>(i % 200) / 100.0f - 1.0f);
+        }
+
+        for (auto format : {WavFormat{WavEncoding::PCM, 2, 48000, 24}, WavFormat{WavEncoding::FLOAT, 2, 48000, 32}})
+        {
+            std::stringstream buffer;
+            {
+                WavWriter writer(buffer, format);
+                writer.write(channels);
+            }
+
+            // The RIFF size counts the bytes after its field, and the data chunk header lies right before the samples
+            {
+                const std::string bytes = buffer.str();
+                const auto* header = reinterpret_cast<const std::uint8_t*>(bytes.data());
+                const std::size_t data_size = 1001 * format.block_align();
+                assert(u32_IO::unpack<Endian::LITTLE>(header + 4) == bytes.size() - 8);
+                assert(u32_IO::unpack<Endian::LITTLE>(header + bytes.size() - data_size - 4) == data_size);
+                assert(std::memcmp(header + bytes.size() - data_size - 8, "data", 4) == 0);
+            }
+
+            // Streamed
+            {
+                WavReader reader(buffer);
+                assert(reader.format().n_channels == 2 && reader.format().sample_rate == 48000);
+                assert(reader.format().bits_per_sample == format.bits_per_sample);
+                assert(reader.n_frames() == 1001);
+
+                std::vector<std::vector<float>> result;
+                assert(reader.read(result, 600) == 600);
+                assert(reader.read(result, 600) == 401);
+                for (int i=0; i<401; i++)
+                    assert(std::abs(result[1][i] - channels[1][600 + i]) <= 1.0f / 8388608);
+            }
+
+            // Memory mapped
+            {
+                const std::string path = "numio_debug.wav";
+                {
+                    std::ofstream file(path, std::ios::binary);
+                    file << buffer.str();
+                }
+                {
+                    WavReader reader(path);
+                    assert(reader.data() != nullptr);
+
+                    std::vector<std::vector<double>> result;
+                    assert(reader.read(result, 2000) == 1001);
+                    for (int i=0; i<1001; i++)
+                        assert(std::abs(result[0][i] - channels[0][i]) <= 1.0 / 8388608);
+                }
+                std::remove(path.c_str());
+            }
+        }
+
+        // 8-bit integer samples
+        {
+            std::stringstream buffer;
+            {
+                WavWriter writer(buffer, WavFormat{WavEncoding::PCM, 1, 8000, 8});
+                writer.write(std::vector<std::vector<std::int32_t>>{{-128, -1, 0, 127}});
+            }
+            assert(u32_IO::unpack<Endian::LITTLE>(reinterpret_cast<const std::uint8_t*>(buffer.str().data()) + 4) ==
+                   buffer.str().size() - 8);
+
+            // Odd sized data chunk is padded, which counts towards the RIFF size
+            {
+                std::stringstream odd;
+                {
+                    WavWriter writer(odd, WavFormat{WavEncoding::PCM, 1, 8000, 8});
+                    writer.write(std::vector<std::vector<std::int32_t>>{{-128, -1, 0}});
+                }
+                const std::string bytes = odd.str();
+                assert(bytes.size() % 2 == 0);
+                assert(u32_IO::unpack<Endian::LITTLE>(reinterpret_cast<const std::uint8_t*>(bytes.data()) + 4) ==
+                       bytes.size() - 8);
+                assert(u32_IO::unpack<Endian::LITTLE>(reinterpret_cast<const std::uint8_t*>(bytes.data()) + bytes.size() - 8) == 3);
+            }
+
+            WavReader reader(buffer);
+            std::vector<std::vector<std::int32_t>> result;
+            reader.read(result, 4);
+            assert((result[0] == std::vector<std::int32_t>{-128, -1, 0, 127}));
+        }
+        // Frames must fit the 16-bit block align field, which must match the format
+        assert(!(WavFormat{WavEncoding::FLOAT, 8192, 48000, 64}.is_supported()));
+        assert(!(WavFormat{WavEncoding::PCM, 65535, 48000, 32}.is_supported()));
+        assert((WavFormat{WavEncoding::PCM, 21845, 48000, 24}.is_supported()));
+        {
+            std::stringstream buffer;
+            {
+                WavWriter writer(buffer, WavFormat{WavEncoding::PCM, 2, 8000, 16});
+                writer.write(std::vector<std::vector<std::int32_t>>{{1, 2}, {3, 4}});
+            }
+            std::string bytes = buffer.str();
+            assert(bytes[48 + 8 + 12] == 4);
+            bytes[48 + 8 + 12] = 2;
+            std::stringstream crafted(bytes);
+            bool has_thrown = false;
+            try { WavReader reader(crafted); }
+            catch (const std::runtime_error&) { has_thrown = true; }
+            assert(has_thrown);
+        }
+
+        // A corrupt format chunk size is rejected before allocating its body
+        {
+            std::stringstream buffer;
+            buffer.write("RIFF\0\0\0\0WAVEfmt \xFF\xFF\xFF\xFF", 20);
+            bool has_thrown = false;
+            try { WavReader reader(buffer); }
+            catch (const std::runtime_error&) { has_thrown = true; }
+            assert(has_thrown);
+        }
+    }
+
+    // NumPy
+    {
+        const std::string path = "numio_debug.npy";
+        std::vector<float> values;
+        for (int i=0; i<12; i++)
+            values.push_back(i * 0.25f - 1.0f);
+
+        // Native byte order is viewed in place
+        {
+            {
+                std::ofstream file(path, std::ios::binary);
+                NpyWriter::write<Endian::NATIVE>(file, values.data(), {3, 4});
+                assert(file.tellp() % 64 == 12 * 4);
+            }
+            NpyReader reader(path);
+            assert(reader.dtype() == NpyDtype::of<float>());
+            assert((reader.shape() == std::vector<std::size_t>{3, 4}) && reader.size() == 12);
+            assert(!reader.fortran_order());
+            assert(reader.is_viewable<float>() && !reader.is_viewable<double>());
+            const float* view = reader.view<float>();
+            assert(std::equal(values.begin(), values.end(), view));
+            assert(reader.to_vector<double>()[5] == values[5]);
+        }
+
+        // Big endian integers are converted
+        {
+            std::vector<std::int32_t> integers = {1, -2, 300000, -400000};
+            {
+                std::ofstream file(path, std::ios::binary);
+                NpyWriter::write<Endian::BIG>(file, integers);
+            }
+            NpyReader reader(path);
+            assert(reader.dtype().descr() == ">i4");
+            assert((reader.shape() == std::vector<std::size_t>{4}));
+            assert(!reader.is_viewable<std::int32_t>());
+            assert(reader.to_vector<std::int32_t>() == integers);
+            assert(reader.to_vector<double>()[3] == -400000.0);
+        }
+
+        // A shape of which the amount of elements overflows is rejected, instead of wrapping to an empty array
+        {
+            std::string dict = "{'descr': '<f4', 'fortran_order': False, 'shape': (4294967296, 4294967296), }";
+            dict.resize(117, ' ');
+            dict += '\n';
+            {
+                std::ofstream file(path, std::ios::binary);
+                file << std::string("\x93NUMPY\x01\x00", 8) << static_cast<char>(dict.size()) << '\0' << dict;
+            }
+            bool has_thrown = false;
+            try { NpyReader reader(path); }
+            catch (const std::runtime_error&) { has_thrown = true; }
+            assert(has_thrown);
+        }
+
+        // Malformed numbers in the header are rejected as malformed files
+        for (const char* descr : {"<fX", "<f4x", "<f-4", "<f99999999999999999999", "<f4294967300"}) {
+            std::string dict = std::string("{'descr': '") + descr + "', 'fortran_order': False, 'shape': (2,), }";
+            dict.resize(117, ' ');
+            dict += '\n';
+            {
+                std::ofstream file(path, std::ios::binary);
+                file << std::string("\x93NUMPY\x01\x00", 8) << static_cast<char>(dict.size()) << '\0' << dict
+                     << std::string(16, '\0');
+            }
+            bool has_thrown = false;
+            try { NpyReader reader(path); }
+            catch (const std::runtime_error&) { has_thrown = true; }
+            assert(has_thrown);
+        }
+
+        // Bools are converted element-wise, as std::vector<bool> is packed
+        {
+            std::vector<bool> flags = {true, false, false, true, true};
+            {
+                std::ofstream file(path, std::ios::binary);
+                NpyWriter::write(file, flags);
+            }
+            NpyReader reader(path);
+            assert(reader.dtype().descr() == "|b1");
+            assert(reader.to_vector<bool>() == flags);
+            assert((reader.to_vector<int>() == std::vector<int>{1, 0, 0, 1, 1}));
+        }
+
+        // Headers are written as version 2 when their padded size doesn't fit in version 1
+        for (std::size_t n_dimensions=21800; n_dimensions<21850; n_dimensions++) {
+            {
+                std::ofstream file(path, std::ios::binary);
+                const double value = 1.5;
+                NpyWriter::write(file, &value, std::vector<std::size_t>(n_dimensions, 1));
+                assert(file.tellp() % 64 == 8);
+            }
+            NpyReader reader(path);
+            assert(reader.shape().size() == n_dimensions);
+            assert(reader.to_vector<double>()[0] == 1.5);
+        }
+
+        std::remove(path.c_str());
+    }
+
+    // FITS
+    {
+        const std::string path = "numio_debug.fits";
+        std::string header;
+        auto card = [&](const std::string& keyword, const std::string& value) {
+            std::string line = keyword;
+            line.resize(8, ' ');
+            if (!value.empty())
+                line += "= " + value;
+            line.resize(80, ' ');
+            header += line;
+        };
+        auto pad = [](std::string& s, char c) { s.resize((s.size() + 2879) / 2880 * 2880, c); };
+
+        // Unsigned 16-bit image through BZERO, followed by a binary table
+        card("SIMPLE", "T");
+        card("BITPIX", "16");
+        card("NAXIS", "2");
+        card("NAXIS1", "3");
+        card("NAXIS2", "2");
+        card("BZERO", "32768");
+        card("BSCALE", "1.0D0 / Fortran exponent");
+        card("END", "");
+        pad(header, ' ');
+        std::vector<std::uint8_t> image;
+        for (std::uint16_t value : {0, 1, 32768, 40000, 65535, 7})
+            i16_IO::pack<Endian::BIG>(static_cast<std::int16_t>(value ^ 0x8000), image);
+        std::string data(image.begin(), image.end());
+        pad(data, '\0');
+
+        std::string table;
+        std::swap(header, table);
+        card("XTENSION", "'BINTABLE'");
+        card("BITPIX", "8");
+        card("NAXIS", "2");
+        card("NAXIS1", "24");
+        card("NAXIS2", "2");
+        card("PCOUNT", "0");
+        card("GCOUNT", "1");
+        card("TFIELDS", "6");
+        card("TTYPE1", "'NAME    '");
+        card("TFORM1", "'2A'");
+        card("TTYPE2", "'COUNT'");
+        card("TFORM2", "'1J'");
+        card("TSCAL2", "0.5");
+        card("TZERO2", "10");
+        card("TTYPE3", "'FLUX'");
+        card("TFORM3", "'2E'");
+        card("TTYPE4", "'VALID'");
+        card("TFORM4", "'2L'");
+        card("TTYPE5", "'BIG'");
+        card("TFORM5", "'1J'");
+        card("TZERO5", "100000003");
+        card("TTYPE6", "'BIGNULL'");
+        card("TFORM6", "'1J'");
+        card("TZERO6", "100000003");
+        card("TNULL6", "-999");
+        card("END", "");
+        pad(header, ' ');
+        std::vector<std::uint8_t> rows;
+        for (int row=0; row<2; row++) {
+            rows.push_back('a');
+            rows.push_back('b');
+            i32_IO::pack<Endian::BIG>(row * 4, rows);
+            fp32_IO::pack<Endian::BIG>(row + 0.5f, rows);
+            fp32_IO::pack<Endian::BIG>(-row - 0.25f, rows);
+            rows.push_back(row ? 0 : 'T');
+            rows.push_back(row ? 'T' : 'F');
+            i32_IO::pack<Endian::BIG>(row ? -999 : 2, rows);
+            i32_IO::pack<Endian::BIG>(row ? -999 : 2, rows);
+        }
+        std::string table_data(rows.begin(), rows.end());
+        pad(table_data, '\0');
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << table << data << header << table_data;
+        }
+
+        FitsReader reader(path);
+        assert(reader.hdus().size() == 2);
+        assert(reader.hdus()[0].type() == "PRIMARY" && reader.hdus()[1].type() == "BINTABLE");
+        assert((reader.hdus()[0].axes() == std::vector<std::size_t>{3, 2}));
+        assert(reader.hdus()[1].get("TTYPE1") == "NAME");
+
+        std::vector<std::uint16_t> pixels;
+        reader.read_image(0, pixels);
+        assert((pixels == std::vector<std::uint16_t>{0, 1, 32768, 40000, 65535, 7}));
+        std::vector<float> scaled;
+        reader.read_image(0, scaled);
+        assert(scaled[3] == 40000.0f);
+
+        std::vector<double> counts;
+        reader.read_column(1, "COUNT", counts);
+        assert((counts == std::vector<double>{10.0, 12.0}));
+        std::vector<float> flux;
+        reader.read_column(1, "FLUX", flux);
+        assert((flux == std::vector<float>{0.5f, -0.25f, 1.5f, -1.25f}));
+        std::vector<std::uint8_t> valid;
+        reader.read_column(1, "VALID", valid);
+        assert((valid == std::vector<std::uint8_t>{1, 0, 0, 1}));
+
+        // Scaling is as precise with and without null values
+        std::vector<float> big, big_null;
+        reader.read_column(1, "BIG", big);
+        reader.read_column(1, "BIGNULL", big_null);
+        assert(big[0] == static_cast<float>(100000005.0) && big[1] == static_cast<float>(100000003.0 - 999));
+        assert(big_null[0] == big[0] && std::isnan(big_null[1]));
+
+        // Malformed sizes are rejected instead of reading out of bounds. Cards are replaced by cards of equal length
+        auto is_rejected = [&](std::size_t start, std::vector<std::pair<std::string, std::string>> cards) {
+            std::string crafted = table + data + header + table_data;
+            for (auto& [from, to] : cards) {
+                assert(from.size() == to.size());
+                crafted.replace(crafted.find(from, start), from.size(), to);
+            }
+            {
+                std::ofstream file(path, std::ios::binary);
+                file << crafted;
+            }
+            bool has_thrown = false;
+            try {
+                FitsReader crafted_reader(path);
+                std::vector<float> column;
+                crafted_reader.read_column(1, "FLUX", column);
+            }
+            catch (const std::runtime_error&) { has_thrown = true; }
+            return has_thrown;
+        };
+        const std::size_t extension = table.size() + data.size();
+        assert(is_rejected(extension, {{"NAXIS1  = 24", "NAXIS1  = 08"}}));      // Columns exceed the row
+        assert(is_rejected(extension, {{"GCOUNT  = 1", "GCOUNT  = 0"}}));        // Rows exceed the data
+        assert(is_rejected(0, {{"NAXIS1  = 3          ", "NAXIS1  = 4294967296 "},
+                               {"NAXIS2  = 2          ", "NAXIS2  = 4294967296 "}}));  // Data size wraps to 0
+
+        std::remove(path.c_str());
+    }
+
+    // Packet captures
+    {
+        const std::string path = "numio_debug.pcap";
+        const std::vector<std::uint8_t> payload = {0xDE, 0xAD, 0xBE, 0xEF, 0x01};
+
+        // Classic pcap in big endian with nanosecond timestamps
+        {
+            std::vector<std::uint8_t> data;
+            for (std::uint32_t value : {0xA1B23C4Du, 0x00020004u, 0u, 0u, 65535u, 1u})
+                u32_IO::pack<Endian::BIG>(value, data);
+            for (std::uint32_t i=0; i<2; i++) {
+                for (std::uint32_t value : {1700000000u + i, 123u, static_cast<std::uint32_t>(payload.size()), 60u})
+                    u32_IO::pack<Endian::BIG>(value, data);
+                data.insert(data.end(), payload.begin(), payload.end());
+            }
+            std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), data.size());
+
+            PcapReader reader(path);
+            assert(reader.format() == CaptureFormat::PCAP && reader.endianness() == Endian::BIG);
+            PcapPacket packet;
+            assert(reader.next(packet));
+            assert(packet.timestamp == 1700000000ull * 1000000000ull + 123);
+            assert(packet.original_length == 60 && packet.link_type == 1);
+            assert(std::equal(payload.begin(), payload.end(), packet.data) && packet.size == payload.size());
+            assert(reader.next(packet) && !reader.next(packet));
+
+            reader.rewind();
+            assert(reader.for_each([](const PcapPacket& p) { assert(p.size == 5); }) == 2);
+        }
+
+        // pcapng with a little endian section followed by a big endian section
+        {
+            std::vector<std::uint8_t> data;
+            auto write_section = [&](auto endianness) {
+                constexpr Endian E = decltype(endianness)::value;
+                auto block = [&](std::uint32_t type, std::vector<std::uint8_t> body) {
+                    body.resize((body.size() + 3) / 4 * 4, 0);
+                    const std::uint32_t length = static_cast<std::uint32_t>(12 + body.size());
+                    u32_IO::pack<E>(type, data);
+                    u32_IO::pack<E>(length, data);
+                    data.insert(data.end(), body.begin(), body.end());
+                    u32_IO::pack<E>(length, data);
+                };
+
+                std::vector<std::uint8_t> body;
+                u32_IO::pack<E>(0x1A2B3C4Du, body);
+                u16_IO::pack<E>(1, body);
+                u16_IO::pack<E>(0, body);
+                i64_IO::pack<E>(-1, body);
+                block(0x0A0D0D0Au, body);
+
+                // Ethernet interface with nanosecond resolution (if_tsresol = 9)
+                body.clear();
+                u16_IO::pack<E>(1, body);
+                u16_IO::pack<E>(0, body);
+                u32_IO::pack<E>(0, body);
+                u16_IO::pack<E>(9, body);
+                u16_IO::pack<E>(1, body);
+                body.insert(body.end(), {9, 0, 0, 0});
+                u32_IO::pack<E>(0, body);
+                block(1, body);
+
+                // Unknown block type, skipped
+                block(0x00000BADu, {1, 2, 3, 4});
+
+                body.clear();
+                for (std::uint32_t value : {0u, 1u, 500u, static_cast<std::uint32_t>(payload.size()), 64u})
+                    u32_IO::pack<E>(value, body);
+                body.insert(body.end(), payload.begin(), payload.end());
+                block(6, body);
+
+                body.clear();
+                u32_IO::pack<E>(static_cast<std::uint32_t>(payload.size()), body);
+                body.insert(body.end(), payload.begin(), payload.end());
+                block(3, body);
+            };
+            write_section(std::integral_constant<Endian, Endian::LITTLE>());
+            write_section(std::integral_constant<Endian, Endian::BIG>());
+            std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), data.size());
+
+            PcapReader reader(path);
+            assert(reader.format() == CaptureFormat::PCAPNG && reader.endianness() == Endian::LITTLE);
+            PcapPacket packet;
+            for (int section=0; section<2; section++) {
+                assert(reader.next(packet));
+                assert(packet.timestamp == (1ull << 32) + 500 && packet.original_length == 64);
+                assert(std::equal(payload.begin(), payload.end(), packet.data) && packet.size == payload.size());
+                assert(reader.next(packet));
+                assert(packet.original_length == payload.size() && packet.size == payload.size());
+            }
+            assert(reader.endianness() == Endian::BIG);
+            assert(!reader.next(packet));
+
+            reader.rewind();
+            std::size_t n_bytes = 0;
+            assert(reader.for_each([&](const PcapPacket& p) { n_bytes += p.size; }) == 4);
+            assert(n_bytes == 4 * payload.size());
+        }
+
+        std::remove(path.c_str());
+    }
+
+    // TIFF
+    {
+        const std::string path = "numio_debug.tif";
+        auto build = [](auto endianness) {
+            constexpr Endian E = decltype(endianness)::value;
+            std::vector<std::uint8_t> data = {E == Endian::LITTLE ? std::uint8_t('I') : std::uint8_t('M'),
+                                              E == Endian::LITTLE ? std::uint8_t('I') : std::uint8_t('M')};
+            u16_IO::pack<E>(42, data);
+            u32_IO::pack<E>(8, data);
+            auto entry = [&](std::uint16_t tag, TiffType type, std::uint32_t count, std::uint32_t value) {
+                u16_IO::pack<E>(tag, data);
+                u16_IO::pack<E>(static_cast<std::uint16_t>(type), data);
+                u32_IO::pack<E>(count, data);
+                u32_IO::pack<E>(value, data);
+            };
+
+            // IFD0 at 8 with 4 entries (out of order), next IFD at 62, out-of-line values from 80
+            u16_IO::pack<E>(4, data);
+            entry(282, TiffType::RATIONAL, 1, 80);
+            entry(256, TiffType::SHORT, 1, 0);
+            i16_IO::pack<E>(640, data.data() + data.size() - 4);
+            entry(271, TiffType::ASCII, 6, 88);
+            entry(TiffTag::EXIF_IFD, TiffType::LONG, 1, 96);
+            u32_IO::pack<E>(62, data);
+            // IFD1 at 62 with a single entry and no next IFD
+            u16_IO::pack<E>(1, data);
+            entry(257, TiffType::LONG, 1, 480);
+            u32_IO::pack<E>(0, data);
+            data.resize(80);
+            u32_IO::pack<E>(72, data);
+            u32_IO::pack<E>(1, data);
+            for (char c : std::string("Canon\0"))
+                data.push_back(static_cast<std::uint8_t>(c));
+            data.resize(96);
+            // EXIF IFD at 96
+            u16_IO::pack<E>(2, data);
+            entry(33434, TiffType::RATIONAL, 1, 126);
+            entry(37500, TiffType::SSHORT, 2, 0);
+            i16_IO::pack<E>(-5, data.data() + data.size() - 4);
+            i16_IO::pack<E>(7, data.data() + data.size() - 2);
+            u32_IO::pack<E>(0, data);
+            u32_IO::pack<E>(1, data);
+            u32_IO::pack<E>(250, data);
+            return data;
+        };
+
+        auto check = [](const TiffReader& reader) {
+            assert(reader.ifds().size() == 2);
+            const TiffIfd& ifd = reader.ifds()[0];
+            assert(ifd.entries.size() == 4 && ifd.entries[0].tag == 256);
+            assert(reader.value<std::uint32_t>(*ifd.find(256)) == 640);
+            assert(reader.string(*ifd.find(271)) == "Canon");
+            assert(reader.value<double>(*ifd.find(282)) == 72.0);
+            assert(ifd.find(1234) == nullptr);
+            assert(reader.value<int>(*reader.ifds()[1].find(257)) == 480);
+
+            TiffIfd exif = reader.child_ifds(*ifd.find(TiffTag::EXIF_IFD))[0];
+            assert(reader.value<double>(*exif.find(33434)) == 1.0 / 250);
+            std::vector<int> values;
+            reader.values(*exif.find(37500), values);
+            assert((values == std::vector<int>{-5, 7}));
+            assert(reader.value<int>(*exif.find(37500), 1) == 7);
+        };
+
+        std::vector<std::uint8_t> big = build(std::integral_constant<Endian, Endian::BIG>());
+        TiffReader big_reader(big.data(), big.size());
+        assert(big_reader.endianness() == Endian::BIG);
+        check(big_reader);
+
+        std::vector<std::uint8_t> little = build(std::integral_constant<Endian, Endian::LITTLE>());
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(little.data()), little.size());
+        {
+            TiffReader little_reader(path);
+            assert(little_reader.endianness() == Endian::LITTLE);
+            check(little_reader);
+        }
+
+        // A cyclic IFD chain is rejected
+        u32_IO::pack<Endian::BIG>(8, big.data() + 62 + 2 + 12);
+        bool has_thrown = false;
+        try { TiffReader reader(big.data(), big.size()); }
+        catch (const std::runtime_error&) { has_thrown = true; }
+        assert(has_thrown);
+
+        // Counts and offsets taken from the file are bounds checked before use
+        auto is_rejected = [&](std::uint16_t type, std::uint32_t count, std::uint32_t offset, std::size_t index) {
+            TiffEntry entry;
+            entry.tag = 1234;
+            entry.type = type;
+            entry.count = count;
+            entry.offset = offset;
+            try {
+                std::vector<std::uint32_t> values;
+                if (index == 0)
+                    big_reader.values(entry, values);
+                else
+                    big_reader.value<std::uint32_t>(entry, index);
+            }
+            catch (const std::runtime_error&) { return true; }
+            return false;
+        };
+        assert(is_rejected(static_cast<std::uint16_t>(TiffType::LONG), 0xFFFFFFFF, 8, 0));
+        assert(is_rejected(0xFFFF, 0xFFFFFFFF, 8, 0));
+        assert(is_rejected(static_cast<std::uint16_t>(TiffType::LONG), 0x40000000, 0xFFFFFFF0, 4));
+        assert(!is_rejected(static_cast<std::uint16_t>(TiffType::LONG), 2, 4, 1));
+
+        std::remove(path.c_str());
+    }
+
+    // SEG-Y
+    {
+        const std::string path = "numio_debug.sgy";
+
+        // Big endian, fixed length traces of IBM floats
+        {
+            std::vector<std::uint8_t> data(3600, 0);
+            u16_IO::pack<Endian::BIG>(4000, data.data() + 3216);
+            u16_IO::pack<Endian::BIG>(4, data.data() + 3220);
+            u16_IO::pack<Endian::BIG>(1, data.data() + 3224);
+            u16_IO::pack<Endian::BIG>(1, data.data() + 3502);
+            const std::vector<std::uint32_t> ibm = {0x41100000u, 0xC276A000u, 0x40280000u, 0x00000000u};
+            for (std::int32_t trace=0; trace<5; trace++) {
+                std::size_t header = data.size();
+                data.resize(header + 240, 0);
+                i32_IO::pack<Endian::BIG>(trace + 1, data.data() + header);
+                i32_IO::pack<Endian::BIG>(1000 + trace, data.data() + header + 188);
+                for (auto value : ibm)
+                    u32_IO::pack<Endian::BIG>(value ^ (trace % 2 ? 0x80000000u : 0u), data);
+            }
+            std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), data.size());
+
+            SegyReader reader(path);
+            assert(reader.endianness() == Endian::BIG && reader.format() == SegyFormat::IBM_FLOAT);
+            assert(reader.n_traces() == 5 && reader.n_samples(4) == 4 && reader.sample_interval() == 4000);
+            assert(reader.trace_header(3).trace_sequence_line == 4 && reader.trace_header(3).inline_number == 1003);
+
+            std::vector<float> samples = reader.read_traces(0, 5, 3);
+            assert(samples.size() == 20);
+            assert(samples[0] == 1.0f && samples[1] == -118.625f && samples[2] == 0.15625f && samples[3] == 0.0f);
+            assert(samples[4] == -1.0f && samples[5] == 118.625f && samples[16] == 1.0f);
+
+            float trace[4];
+            reader.read_trace(1, trace);
+            assert(std::equal(trace, trace + 4, samples.begin() + 4));
+        }
+
+        // Little endian (revision 2), variable length traces of 16-bit integers
+        {
+            std::vector<std::uint8_t> data(3600, 0);
+            u32_IO::pack<Endian::LITTLE>(0x01020304u, data.data() + 3296);
+            u16_IO::pack<Endian::LITTLE>(3, data.data() + 3224);
+            for (std::uint16_t n_samples : {2, 3, 1}) {
+                std::size_t header = data.size();
+                data.resize(header + 240, 0);
+                u16_IO::pack<Endian::LITTLE>(n_samples, data.data() + header + 114);
+                for (std::int16_t i=0; i<n_samples; i++)
+                    i16_IO::pack<Endian::LITTLE>(static_cast<std::int16_t>(-100 * n_samples + i), data);
+            }
+            std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), data.size());
+
+            SegyReader reader(path);
+            assert(reader.endianness() == Endian::LITTLE && reader.format() == SegyFormat::INT16);
+            assert(reader.n_traces() == 3 && reader.n_samples(1) == 3);
+            std::vector<float> samples = reader.read_traces(0, 3, 2);
+            assert((samples == std::vector<float>{-200, -199, -300, -299, -298, -100}));
+            assert((reader.read_traces(1, 2, 1) == std::vector<float>{-300, -299, -298, -100}));
+        }
+
+        std::remove(path.c_str());
+    }
+
+    // Chunked arrays
+    {
+        const std::string path = "numio_debug.nck";
+
+        // 24-bit integers with every encoding, in chunks of 256 values
+        {
+            std::vector<std::int32_t> values(1000);
+            for (std::size_t i=0; i<values.size(); i++)
+                values[i] = static_cast<std::int32_t>((i * 7919) % 4001) - 2000;
+            {
+                std::ofstream file(path, std::ios::binary);
+                ChunkedWriter<i24_IO, Endian::BIG> writer(file, 256, ChunkEncoding::BIT_PACKED);
+                writer.write(values.data(), 300);
+                writer.set_encoding(ChunkEncoding::SHUFFLED);
+                writer.write(values.data() + 300, 400);
+                writer.set_encoding(ChunkEncoding::RAW);
+                writer.write(values.data() + 700, 300);
+            }
+
+            ChunkedReader<i24_IO> reader(path);
+            assert(reader.descriptor() == ChunkedDescriptor::of<i24_IO>(Endian::BIG));
+            assert(reader.size() == 1000 && reader.chunk_size() == 256 && reader.chunks().size() == 4);
+            assert(reader.chunks()[0].encoding == ChunkEncoding::BIT_PACKED);
+            assert(reader.chunks()[0].n_bytes < 256 * 3);
+            assert(reader.chunks()[1].encoding == ChunkEncoding::SHUFFLED);
+            assert(reader.chunks()[3].count == 1000 - 3 * 256);
+            const auto& first = reader.chunks()[0];
+            assert(first.min == *std::min_element(values.begin(), values.begin() + 256));
+            assert(first.max == *std::max_element(values.begin(), values.begin() + 256));
+            assert(reader.to_vector() == values);
+
+            std::vector<std::int32_t> range(500);
+            reader.read(250, range.size(), range.data());
+            assert(std::equal(range.begin(), range.end(), values.begin() + 250));
+        }
+
+        // Bit-packing the full 64-bit range and a constant chunk
+        {
+            std::vector<std::int64_t> values = {INT64_MIN, -1, 0, INT64_MAX, 5, 5, 5, 5};
+            {
+                std::ofstream file(path, std::ios::binary);
+                ChunkedWriter<i64_IO> writer(file, 4, ChunkEncoding::BIT_PACKED);
+                writer.write(values);
+            }
+            ChunkedReader<i64_IO> reader(path);
+            assert(reader.to_vector() == values);
+            assert(reader.chunks()[1].n_bytes == 9);
+
+            // Crafted headers and indices are rejected when opening
+            std::string file_bytes;
+            {
+                std::ifstream file(path, std::ios::binary);
+                file_bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+            const std::size_t index_offset = file_bytes.size() - 24 - 2 * 48;
+            auto is_rejected = [&](std::size_t offset, std::uint64_t value) {
+                std::string crafted = file_bytes;
+                u64_IO::pack<Endian::LITTLE>(value, reinterpret_cast<std::uint8_t*>(crafted.data()) + offset);
+                {
+                    std::ofstream file(path, std::ios::binary);
+                    file << crafted;
+                }
+                bool has_thrown = false;
+                try { ChunkedReader<i64_IO> crafted_reader(path); }
+                catch (const std::runtime_error&) { has_thrown = true; }
+                return has_thrown;
+            };
+            assert(is_rejected(24, 0));                                   // Chunk size of zero
+            assert(is_rejected(index_offset + 16, 3));                    // Partial middle chunk
+            assert(is_rejected(index_offset + 48 + 16, 0));               // Empty last chunk
+            assert(is_rejected(file_bytes.size() - 16, 1ull << 59));      // Chunk count wrapping the index size
+            assert(is_rejected(index_offset + 8, ~0ull));                 // Chunk size wrapping past the index
+        }
+
+        // Half precision floats, shuffled, with NaN ignored by the statistics
+        {
+            std::vector<float> values = {1.5f, std::nanf(""), -2.0f, 0.25f, 65504.0f};
+            {
+                std::ofstream file(path, std::ios::binary);
+                ChunkedWriter<fp16_IO> writer(file, 8, ChunkEncoding::SHUFFLED);
+                writer.write(values);
+            }
+            ChunkedReader<fp16_IO> reader(path);
+            assert(reader.chunks()[0].min == -2.0f && reader.chunks()[0].max == 65504.0f);
+            std::vector<float> result = reader.to_vector();
+            assert(result[0] == 1.5f && std::isnan(result[1]) && result[4] == 65504.0f);
+
+            bool has_thrown = false;
+            try { ChunkedReader<fp32_IO> wrong(path); }
+            catch (const std::runtime_error&) { has_thrown = true; }
+            assert(has_thrown);
+        }
+
+        std::remove(path.c_str());
+    }
+
+    // Arrow columns
+    {
+        std::vector<std::uint8_t> data;
+        for (std::int32_t value : {5, -1, 70000, -1, -8388608, 1, 2, 3, -1, 4})
+            i24_IO::pack<Endian::BIG>(value, data);
+
+        auto column = ArrowExport<i24_IO>::decode<Endian::BIG>(data.data(), 10);
+        assert(column.length == 10 && column.null_count == 0 && column.validity.size() == 0);
+        assert(reinterpret_cast<std::uintptr_t>(column.data()) % 64 == 0);
+        assert(column.data()[2] == 70000 && column.data()[4] == -8388608);
+        assert(std::string(column.format()) == "i");
+        assert(column.buffers()[0] == nullptr);
+
+        auto nullable = ArrowExport<i24_IO>::decode_nullable<Endian::BIG>(data.data(), 10, -1);
+        assert(nullable.null_count == 3 && nullable.validity.size() == 2);
+        assert(nullable.validity.data()[0] == 0b11110101 && nullable.validity.data()[1] == 0b10);
+        assert(!nullable.is_valid(3) && nullable.is_valid(9));
+        assert(nullable.buffers()[0] == nullable.validity.data());
+
+        std::vector<std::uint8_t> floats;
+        for (float value : {1.0f, std::nanf(""), -0.5f})
+            fp16_IO::pack(value, floats);
+        auto float_column = ArrowExport<fp16_IO>::decode_nullable(floats.data(), 3, std::nanf(""));
+        assert(std::string(float_column.format()) == "f");
+        assert(float_column.null_count == 1 && !float_column.is_valid(1) && float_column.data()[2] == -0.5f);
+
+        std::uint8_t* released = float_column.values.release();
+        assert(released && float_column.values.data() == nullptr);
+        AlignedBuffer::free(released);
+    }
+
+    // CBOR and MessagePack numbers
+    {
+        auto cbor = [](auto value) { std::vector<std::uint8_t> out; Cbor::encode(value, out); return out; };
+        auto msgpack = [](auto value) { std::vector<std::uint8_t> out; MsgPack::encode(value, out); return out; };
+
+        // Smallest integer widths
+        assert((cbor(23) == std::vector<std::uint8_t>{0x17}));
+        assert((cbor(24) == std::vector<std::uint8_t>{0x18, 0x18}));
+        assert((cbor(-500) == std::vector<std::uint8_t>{0x39, 0x01, 0xF3}));
+        assert((cbor(UINT64_MAX) == std::vector<std::uint8_t>{0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}));
+        assert((msgpack(-32) == std::vector<std::uint8_t>{0xE0}));
+        assert((msgpack(-33) == std::vector<std::uint8_t>{0xD0, 0xDF}));
+        assert((msgpack(200) == std::vector<std::uint8_t>{0xCC, 0xC8}));
+        assert((msgpack(70000) == std::vector<std::uint8_t>{0xCE, 0x00, 0x01, 0x11, 0x70}));
+
+        // Shortest exact floats (examples of RFC 8949 appendix A)
+        assert((cbor(1.5) == std::vector<std::uint8_t>{0xF9, 0x3E, 0x00}));
+        assert((cbor(65504.0) == std::vector<std::uint8_t>{0xF9, 0x7B, 0xFF}));
+        assert((cbor(5.960464477539063e-8) == std::vector<std::uint8_t>{0xF9, 0x00, 0x01}));
+        assert((cbor(100000.0) == std::vector<std::uint8_t>{0xFA, 0x47, 0xC3, 0x50, 0x00}));
+        assert((cbor(1.1) == std::vector<std::uint8_t>{0xFB, 0x3F, 0xF1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9A}));
+        assert((cbor(-4.0f) == std::vector<std::uint8_t>{0xF9, 0xC4, 0x00}));
+        assert(cbor(std::numeric_limits<double>::infinity()).size() == 3);
+        assert((msgpack(0.5) == std::vector<std::uint8_t>{0xCA, 0x3F, 0x00, 0x00, 0x00}));
+        assert(msgpack(0.1).size() == 9);
+
+        // The bit-level test agrees with trial conversion for a spread of values
+        for (int i=-2000; i<=2000; i++) {
+            for (double value : {std::ldexp(1.0 + i / 1024.0, i / 8), std::ldexp(1.0 + i / 3.0, i / 64), std::ldexp(i, -24)}) {
+                const bool is_single = static_cast<double>(static_cast<float>(value)) == value;
+                const std::size_t size = cbor(value).size();
+                assert((size == 9) == !is_single);
+                assert(Cbor::decode<double>(cbor(value).data(), size) == value);
+                assert(MsgPack::decode<double>(msgpack(value).data(), msgpack(value).size()) == value);
+            }
+        }
+
+        // Decoding with range checks
+        std::vector<std::uint8_t> encoded = cbor(-500);
+        std::size_t n_read;
+        assert(Cbor::decode<std::int16_t>(encoded.data(), encoded.size(), &n_read) == -500 && n_read == 3);
+        bool has_thrown = false;
+        try { Cbor::decode<std::int8_t>(encoded.data(), encoded.size()); }
+        catch (const std::runtime_error&) { has_thrown = true; }
+        assert(has_thrown);
+        encoded = msgpack(static_cast<std::int64_t>(100));
+        assert(MsgPack::decode<std::uint8_t>(encoded.data(), encoded.size()) == 100);
+
+        // Arrays
+        std::vector<std::int32_t> integers(20);
+        for (std::size_t i=0; i<integers.size(); i++)
+            integers[i] = static_cast<std::int32_t>(i * i * i) - 3000;
+        std::vector<std::int32_t> decoded_integers;
+        encoded.clear();
+        Cbor::encode_array(integers.data(), integers.size(), encoded);
+        assert(Cbor::decode_array(encoded.data(), encoded.size(), decoded_integers) == encoded.size());
+        assert(decoded_integers == integers);
+        encoded.clear();
+        MsgPack::encode_array(integers.data(), integers.size(), encoded);
+        assert(encoded[0] == 0xDC);
+        assert(MsgPack::decode_array(encoded.data(), encoded.size(), decoded_integers) == encoded.size());
+        assert(decoded_integers == integers);
+    }
+
+    // Order-preserving keys
+    {
+        // memcmp order equals numeric order
+        auto check_order = [](auto io_tag, const auto& sorted_values) {
+            using KEY_IO_T = decltype(io_tag);
+            std::vector<std::uint8_t> keys(sorted_values.size() * KEY_IO_T::N_IO_BYTES);
+            KEY_IO_T::pack(sorted_values.data(), sorted_values.size(), keys.data());
+            for (std::size_t i=1; i<sorted_values.size(); i++) {
+                assert(std::memcmp(keys.data() + (i - 1) * KEY_IO_T::N_IO_BYTES,
+                                   keys.data() + i * KEY_IO_T::N_IO_BYTES, KEY_IO_T::N_IO_BYTES) < 0);
+            }
+            std::vector<typename KEY_IO_T::value_type> decoded(sorted_values.size());
+            KEY_IO_T::unpack(keys.data(), decoded.size(), decoded.data());
+            for (std::size_t i=0; i<decoded.size(); i++)
+                assert(decoded[i] == sorted_values[i] || (decoded[i] != decoded[i] && sorted_values[i] != sorted_values[i]));
+        };
+
+        check_order(i8_key_IO(), std::vector<std::int8_t>{-128, -1, 0, 1, 127});
+        check_order(i24_key_IO(), std::vector<std::int32_t>{-8388608, -65536, -1, 0, 255, 256, 8388607});
+        check_order(u24_key_IO(), std::vector<std::uint32_t>{0, 1, 0xFFFF, 0x10000, 0xFFFFFF});
+        check_order(i40_key_IO(), std::vector<std::int64_t>{-(1ll << 39), -(1ll << 32), -1, 0, 1ll << 32, (1ll << 39) - 1});
+        check_order(i64_key_IO(), std::vector<std::int64_t>{INT64_MIN, -1, 0, INT64_MAX});
+        check_order(u64_key_IO(), std::vector<std::uint64_t>{0, 1, 1ull << 63, UINT64_MAX});
+        assert(i24_key_IO::N_IO_BYTES == 3 && i40_key_IO::N_IO_BYTES == 5);
+
+        const float inf = std::numeric_limits<float>::infinity();
+        check_order(fp32_key_IO(), std::vector<float>{-inf, -3.5f, -1e-40f, -0.0f, 0.0f, 1e-40f, 1.0f, 3.0e38f, inf, std::nanf("")});
+        check_order(fp16_key_IO(), std::vector<float>{-inf, -2.0f, -0.5f, 0.0f, 0.25f, 65504.0f, inf});
+        check_order(fp64_key_IO(), std::vector<double>{-1e300, -1.0, 0.0, 5e-324, 2.0});
+
+        // Composite keys: (string ascending, i24 descending, f64 ascending)
+        auto make_key = [](const std::string& name, std::int32_t id, double score) {
+            KeyBuilder builder;
+            builder.add_string(name).add<i24_key_IO>(id, true).add<fp64_key_IO>(score);
+            return builder.bytes();
+        };
+        std::vector<std::vector<std::uint8_t>> keys = {
+            make_key("a", 5, 1.0), make_key("a", 5, 2.0), make_key("a", -3, 0.0),
+            make_key(std::string("a\0b", 3), 100, 0.0), make_key("ab", 0, 0.0), make_key("b", 0, -1.0),
+        };
+        assert(std::is_sorted(keys.begin(), keys.end()));
+
+        KeyParser parser(keys[3].data(), keys[3].size());
+        assert(parser.next_string() == std::string("a\0b", 3));
+        assert(parser.next<i24_key_IO>(true) == 100);
+        assert(parser.next<fp64_key_IO>() == 0.0);
+        assert(parser.remaining() == 0);
+    }
+
+    // Radix sort of packed keys
+    {
+        // Enough keys for the sort to use multiple threads
+        std::uint64_t state = 0x9E3779B97F4A7C15ull;
+        auto next_random = [&state]() {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            return state >> 16;
+        };
+
+        std::vector<std::int64_t> values(300000);
+        for (auto& value : values)
+            value = static_cast<std::int64_t>(next_random() % (1ull << 40)) - (1ll << 39);
+        std::vector<std::uint8_t> keys(values.size() * i40_key_IO::N_IO_BYTES);
+        i40_key_IO::pack(values.data(), values.size(), keys.data());
+        RadixSort::sort<i40_key_IO>(keys, 4);
+
+        std::vector<std::int64_t> decoded(values.size());
+        i40_key_IO::unpack(keys.data(), decoded.size(), decoded.data());
+        std::sort(values.begin(), values.end());
+        assert(decoded == values);
+
+        // 3-byte keys with constant high bytes, single-threaded
+        std::vector<std::int32_t> small_values = {5, -3, 200, 0, -3, 17, 1, -128};
+        std::vector<std::uint8_t> small_keys(small_values.size() * i24_key_IO::N_IO_BYTES);
+        i24_key_IO::pack(small_values.data(), small_values.size(), small_keys.data());
+        RadixSort::sort<i24_key_IO>(small_keys.data(), small_values.size());
+        std::vector<std::int32_t> small_decoded(small_values.size());
+        i24_key_IO::unpack(small_keys.data(), small_decoded.size(), small_decoded.data());
+        std::sort(small_values.begin(), small_values.end());
+        assert(small_decoded == small_values);
+
+        // Records with a payload after the key are sorted stably
+        std::vector<std::uint8_t> records;
+        for (std::uint8_t i=0; i<200; i++) {
+            const std::uint8_t record[7] = {0, static_cast<std::uint8_t>(i % 7), static_cast<std::uint8_t>(i % 3), i, 0, 0, 0};
+            records.insert(records.end(), record, record + 7);
+        }
+        RadixSort::sort(records.data(), 200, 7, 3);
+        for (std::size_t i=1; i<200; i++) {
+            const std::uint8_t* previous = records.data() + (i - 1) * 7;
+            const std::uint8_t* current = records.data() + i * 7;
+            const int order = std::memcmp(previous, current, 3);
+            assert(order < 0 || (order == 0 && previous[3] < current[3]));
+        }
+
+        bool has_thrown = false;
+        try { RadixSort::sort(records.data(), 200, 2, 3); } catch (const std::invalid_argument&) { has_thrown = true; }
+        assert(has_thrown);
+    }
+
+    // Searching packed sorted arrays
+    {
+        using u40_IO = IntIO<std::uint64_t, 40, false>;
+        using SEARCH = PackedSearch<u40_IO>;
+
+        // Index entries: 5-byte big endian key followed by a 3-byte payload
+        const std::vector<std::uint64_t> keys = {3, 7, 7, 7, 20, 1ull << 36, (1ull << 36) + 1, (1ull << 40) - 1};
+        const std::size_t STRIDE = 8;
+        std::vector<std::uint8_t> index(keys.size() * STRIDE, 0xEE);
+        for (std::size_t i=0; i<keys.size(); i++)
+            u40_IO::pack<Endian::BIG>(keys[i], index.data() + i * STRIDE);
+
+        std::vector<std::uint8_t> eytzinger(index.size());
+        SEARCH::to_eytzinger(index.data(), keys.size(), eytzinger.data(), STRIDE);
+
+        for (std::uint64_t value : {0ull, 3ull, 4ull, 7ull, 8ull, 20ull, 1ull << 36, (1ull << 40) - 1, 1ull << 40})
+        {
+            const std::size_t lower = std::lower_bound(keys.begin(), keys.end(), value) - keys.begin();
+            const std::size_t upper = std::upper_bound(keys.begin(), keys.end(), value) - keys.begin();
+            assert(SEARCH::lower_bound<Endian::BIG>(index.data(), keys.size(), value, STRIDE) == lower);
+            assert(SEARCH::upper_bound<Endian::BIG>(index.data(), keys.size(), value, STRIDE) == upper);
+            assert(SEARCH::lower_bound_branchless<Endian::BIG>(index.data(), keys.size(), value, STRIDE) == lower);
+            assert(SEARCH::upper_bound_branchless<Endian::BIG>(index.data(), keys.size(), value, STRIDE) == upper);
+            assert((SEARCH::equal_range<Endian::BIG>(index.data(), keys.size(), value, STRIDE) == std::make_pair(lower, upper)));
+
+            // Eytzinger positions refer to the reordered entries
+            const std::size_t position = SEARCH::eytzinger_lower_bound<Endian::BIG>(eytzinger.data(), keys.size(), value, STRIDE);
+            if (lower == keys.size())
+                assert(position == keys.size());
+            else
+                assert(u40_IO::unpack<Endian::BIG>(eytzinger.data() + position * STRIDE) == keys[lower]);
+            const std::size_t upper_position = SEARCH::eytzinger_upper_bound<Endian::BIG>(eytzinger.data(), keys.size(), value, STRIDE);
+            if (upper == keys.size())
+                assert(upper_position == keys.size());
+            else
+                assert(u40_IO::unpack<Endian::BIG>(eytzinger.data() + upper_position * STRIDE) == keys[upper]);
+        }
+        assert(eytzinger[5] == 0xEE && eytzinger[7] == 0xEE);
+        assert(SEARCH::lower_bound(index.data(), 0, 1) == 0 && SEARCH::eytzinger_lower_bound(index.data(), 0, 1) == 0);
+
+        // Floats, default stride
+        const std::vector<float> floats = {-2.0f, -0.5f, 0.0f, 1.5f, 1.5f, 100.0f};
+        std::vector<std::uint8_t> packed(floats.size() * fp32_IO::N_IO_BYTES);
+        fp32_IO::pack(floats.data(), floats.size(), packed.data());
+        assert(PackedSearch<fp32_IO>::lower_bound(packed.data(), floats.size(), 1.5f) == 3);
+        assert(PackedSearch<fp32_IO>::upper_bound_branchless(packed.data(), floats.size(), 1.5f) == 5);
+        assert(PackedSearch<fp32_IO>::lower_bound_branchless(packed.data(), floats.size(), -3.0f) == 0);
+    }
+
+    // Float overflow policies
+    {
+        const float inf = std::numeric_limits<float>::infinity();
+        std::uint8_t bytes[2];
+
+        bool has_thrown = false;
+        try { fp16_IO::pack(70000.0f, bytes); } catch (const std::runtime_error&) { has_thrown = true; }
+        assert(has_thrown);
+
+        fp16_IO::pack<Endian::LITTLE, OverflowPolicy::SATURATE>(70000.0f, bytes);
+        assert(fp16_IO::unpack(bytes) == 65504.0f);
+        fp16_IO::pack<Endian::LITTLE, OverflowPolicy::TO_INFINITY>(-70000.0f, bytes);
+        assert(fp16_IO::unpack(bytes) == -inf);
+
+        // Rounding up into the exponent overflows as well
+        assert(fp16_IO::encode<OverflowPolicy::SATURATE>(65520.0f) == 0x7BFF);
+        assert(fp16_IO::encode<OverflowPolicy::TO_INFINITY>(65520.0f) == 0x7C00);
+        assert(fp16_IO::encode<OverflowPolicy::SATURATE>(65519.0f) == 0x7BFF);
+
+        bool is_overflow = false;
+        assert(fp16_IO::encode(-1e10f, is_overflow) == 0xFBFF && is_overflow);
+        is_overflow = false;
+        assert(fp16_IO::encode(inf, is_overflow) == 0x7C00 && !is_overflow);
+        assert(fp16_IO::try_pack(1.5f, bytes) && fp16_IO::unpack(bytes) == 1.5f);
+        assert(!fp16_IO::try_pack<Endian::BIG>(1e6f, bytes) && fp16_IO::unpack<Endian::BIG>(bytes) == 65504.0f);
+
+        const std::vector<float> values = {1.0f, 1e5f, -1e5f, 0.5f, inf, 1e-10f, 65504.0f};
+        std::vector<std::uint8_t> packed(values.size() * fp16_IO::N_IO_BYTES);
+        assert(fp16_IO::try_pack(values.data(), values.size(), packed.data()) == 2);
+        std::vector<float> unpacked(values.size());
+        fp16_IO::unpack(packed.data(), unpacked.size(), unpacked.data());
+        assert((unpacked == std::vector<float>{1.0f, 65504.0f, -65504.0f, 0.5f, inf, 0.0f, 65504.0f}));
+        assert((fp16_IO::try_pack<Endian::LITTLE, OverflowPolicy::TO_INFINITY>(values.data(), values.size(), packed.data()) == 2));
+        assert(fp16_IO::unpack(packed.data() + 2) == inf);
+    }
+
+    // Float rounding modes
+    {
+        // Exactly halfway between 1.0 and the next fp16 value, and between the next two
+        const float tie_even = 1.0f + std::ldexp(1.0f, -11);
+        const float tie_odd = 1.0f + 3 * std::ldexp(1.0f, -11);
+        assert(fp16_IO::encode_rounded<RoundingMode::NEAREST_EVEN>(tie_even) == 0x3C00);
+        assert(fp16_IO::encode_rounded<RoundingMode::NEAREST_EVEN>(tie_odd) == 0x3C02);
+        assert(fp16_IO::encode_rounded<RoundingMode::HALF_AWAY>(tie_even) == 0x3C01);
+        assert(fp16_IO::encode_rounded<RoundingMode::HALF_AWAY>(-tie_odd) == 0xBC02);
+        assert(fp16_IO::encode_rounded<RoundingMode::TOWARD_ZERO>(tie_odd) == 0x3C01);
+        assert(fp16_IO::encode_rounded<RoundingMode::TOWARD_ZERO>(-1.9999f) == 0xBFFF);
+        assert(fp16_IO::encode_rounded<RoundingMode::NEAREST_EVEN>(-1.9999f) == 0xC000);
+        assert(fp16_IO::encode_rounded<RoundingMode::NEAREST_EVEN>(1.3f) == fp16_IO::encode(1.3f));
+
+        // Truncating to bfloat16 keeps the upper bits of the float
+        using bf16_IO = FloatIO<float, std::uint16_t, 8, 7>;
+        float pi = 3.14159265f;
+        std::uint32_t pi_bits;
+        std::memcpy(&pi_bits, &pi, 4);
+        assert(bf16_IO::encode_rounded<RoundingMode::TOWARD_ZERO>(pi) == (pi_bits >> 16));
+
+        // Stochastic rounding is unbiased: a quarter of the way up rounds up about a quarter of the time
+        const std::size_t N = 100000;
+        const float quarter = 1.0f + std::ldexp(1.0f, -12);
+        std::vector<float> values(N, quarter);
+        std::vector<std::uint8_t> packed(N * fp16_IO::N_IO_BYTES);
+        fp16_IO::pack_rounded<Endian::LITTLE, RoundingMode::STOCHASTIC>(values.data(), N, packed.data(), 2, 42);
+        std::vector<float> unpacked(N);
+        fp16_IO::unpack(packed.data(), N, unpacked.data());
+        const std::size_t n_up = std::count(unpacked.begin(), unpacked.end(), 1.0f + std::ldexp(1.0f, -10));
+        assert(std::count(unpacked.begin(), unpacked.end(), 1.0f) + n_up == static_cast<std::ptrdiff_t>(N));
+        assert(n_up > N / 4 - N / 100 && n_up < N / 4 + N / 100);
+
+        // Values below the smallest denormalized value can still round up
+        std::vector<float> tiny(N, std::ldexp(1.0f, -26));
+        fp16_IO::pack_rounded<Endian::LITTLE, RoundingMode::STOCHASTIC>(tiny.data(), N, packed.data(), 2, 7);
+        fp16_IO::unpack(packed.data(), N, unpacked.data());
+        const std::size_t n_denormal = std::count(unpacked.begin(), unpacked.end(), std::ldexp(1.0f, -24));
+        assert(n_denormal > N / 4 - N / 100 && n_denormal < N / 4 + N / 100);
+
+        // Results don't depend on batching, and the runtime mode matches the template mode
+        std::vector<std::uint8_t> split(N * fp16_IO::N_IO_BYTES);
+        fp16_IO::pack_rounded(RoundingMode::STOCHASTIC, values.data(), 1000, split.data(), 2, 42);
+        fp16_IO::pack_rounded(RoundingMode::STOCHASTIC, values.data() + 1000, N - 1000, split.data() + 2000, 2, 42, 1000);
+        fp16_IO::pack_rounded<Endian::LITTLE, RoundingMode::STOCHASTIC>(values.data(), N, packed.data(), 2, 42);
+        assert(split == packed);
+        fp16_IO::pack_rounded(RoundingMode::HALF_AWAY, &tie_even, 1, split.data());
+        assert(fp16_IO::unpack(split.data()) == 1.0f + std::ldexp(1.0f, -10));
+    }
+
+    // Flushing denormalized floats
+    {
+        using fp16_ftz_IO = FloatIO<float, std::uint16_t, 5, 10, false, DenormalMode::FTZ>;
+        using fp16_daz_IO = FloatIO<float, std::uint16_t, 5, 10, false, DenormalMode::DAZ>;
+        using fp32_flush_IO = FloatIO<float, std::uint32_t, 8, 23, false, DenormalMode::FTZ_DAZ>;
+        assert(fp16_ftz_IO::DENORMAL_MODE == DenormalMode::FTZ && fp16_IO::DENORMAL_MODE == DenormalMode::PRESERVE);
+
+        const float denormal = std::ldexp(1.0f, -20);
+        const float min_normal = std::ldexp(1.0f, -14);
+        assert(fp16_IO::encode(denormal) == 0x0010);
+        assert(fp16_ftz_IO::encode(denormal) == 0x0000);
+        assert(fp16_ftz_IO::encode(-denormal) == 0x8000);
+        assert(fp16_ftz_IO::encode(min_normal) == 0x0400);
+        assert(fp16_daz_IO::encode(denormal) == 0x0010);
+
+        assert(fp16_IO::decode(0x0010) == denormal);
+        assert(fp16_ftz_IO::decode(0x0010) == denormal);
+        assert(fp16_daz_IO::decode(0x0010) == 0.0f);
+        assert(std::signbit(fp16_daz_IO::decode(0x8010)) && fp16_daz_IO::decode(0x8010) == 0.0f);
+        assert(fp16_daz_IO::decode(0x0400) == min_normal);
+
+        // Batch functions of the IO type flush as well
+        const float float_denormal = std::numeric_limits<float>::denorm_min() * 12345;
+        const std::vector<float> values = {1.0f, float_denormal, -float_denormal, -2.5f};
+        std::vector<std::uint8_t> packed(values.size() * 4);
+        fp32_flush_IO::pack(values.data(), values.size(), packed.data());
+        std::vector<float> unpacked(values.size());
+        fp32_IO::unpack(packed.data(), unpacked.size(), unpacked.data());
+        assert(unpacked[0] == 1.0f && unpacked[1] == 0.0f && std::signbit(unpacked[2]) && unpacked[3] == -2.5f);
+        fp32_IO::pack(values.data(), values.size(), packed.data());
+        fp32_flush_IO::unpack(packed.data(), unpacked.size(), unpacked.data());
+        assert(unpacked[1] == 0.0f && std::signbit(unpacked[2]) && unpacked[2] == 0.0f);
+        fp32_IO::unpack(packed.data(), unpacked.size(), unpacked.data());
+        assert(unpacked == values);
+    }
+
+    // Bounds checked batches
+    {
+        std::vector<std::uint8_t> bytes(10);
+        const std::int32_t values[3] = {-1, 2, -3};
+        std::int32_t out[3] = {};
+
+        // Three 24-bit values with a stride of 4 need 11 bytes
+        bool has_thrown = false;
+        try { i24_IO::pack_checked(values, 3, bytes.data(), bytes.size(), 4); } catch (const std::runtime_error&) { has_thrown = true; }
+        assert(has_thrown);
+        assert(!i24_IO::try_unpack(bytes.data(), bytes.size(), 3, out, 4));
+        assert(out[0] == 0 && out[2] == 0);
+
+        i24_IO::pack_checked(values, 3, bytes.data(), bytes.size(), 3);
+        assert(i24_IO::try_unpack(bytes.data(), bytes.size(), 3, out));
+        assert(out[0] == -1 && out[1] == 2 && out[2] == -3);
+        i24_IO::unpack_checked(bytes.data(), 9, 3, out);
+        assert(i24_IO::try_unpack(bytes.data(), 0, 0, out));
+        assert(!i24_IO::try_unpack(bytes.data(), 2, 1, out));
+
+        // Huge counts can't overflow the check
+        has_thrown = false;
+        try { i24_IO::unpack_checked(bytes.data(), bytes.size(), SIZE_MAX / 2, out); } catch (const std::runtime_error&) { has_thrown = true; }
+        assert(has_thrown);
+
+        float floats[2] = {1.5f, -2.0f};
+        fp16_IO::pack_checked(floats, 2, bytes.data(), 4);
+        assert(fp16_IO::try_unpack(bytes.data(), 4, 2, floats) && floats[1] == -2.0f);
+        assert(!fp32_IO::try_unpack(bytes.data(), 7, 2, floats));
+
+        #ifdef NUMIO_CHECK_BOUNDS
+            has_thrown = false;
+            try { u32_IO::unpack(bytes, 7); } catch (const std::runtime_error&) { has_thrown = true; }
+            assert(has_thrown);
+        #endif
+        assert(u32_IO::unpack(bytes, 6) == u32_IO::unpack(bytes.data() + 6));
+    }
+
+    // Reading from streams with a status
+    {
+        std::stringstream stream;
+        const std::int32_t values[3] = {-5, 70000, -8388608};
+        for (std::int32_t value : values)
+            i24_IO::write(value, stream);
+        stream.write("\x01", 1);
+
+        ReadResult<std::int32_t> result = i24_IO::try_read(stream);
+        assert(result && result.status == ReadStatus::OK && result.value == -5);
+
+        std::int32_t out[4] = {};
+        assert(i24_IO::read(stream, out, 4) == 2);
+        assert(out[0] == 70000 && out[1] == -8388608);
+        stream.clear();
+        assert(i24_IO::try_read(stream).status == ReadStatus::END_OF_STREAM);
+
+        // Truncated value, also with exceptions enabled on the stream
+        std::stringstream truncated("\x01\x02");
+        truncated.exceptions(std::ios::failbit | std::ios::eofbit);
+        result = i24_IO::try_read(truncated);
+        assert(!result && result.status == ReadStatus::TRUNCATED && result.value == 0);
+
+        // Batches larger than the internal block
+        std::stringstream floats_stream;
+        std::vector<float> floats(3000);
+        for (std::size_t i=0; i<floats.size(); i++)
+            floats[i] = static_cast<float>(i) * 0.5f;
+        for (float value : floats)
+            fp32_IO::write<Endian::BIG>(value, floats_stream);
+        std::vector<float> read_floats(floats.size() + 10);
+        assert(fp32_IO::read<Endian::BIG>(floats_stream, read_floats.data(), read_floats.size()) == floats.size());
+        read_floats.resize(floats.size());
+        assert(read_floats == floats);
+        assert(fp32_IO::try_read(floats_stream).status == ReadStatus::END_OF_STREAM);
+    }
+
+    // Vectors with other allocators and byte types
+    {
+        // Pack into an arena; nothing is freed individually
+        std::uint8_t arena[256];
+        std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena), std::pmr::null_memory_resource());
+        std::pmr::vector<std::uint8_t> bytes(&resource);
+        bytes.reserve(64);
+
+        i24_IO::pack<Endian::BIG>(-2, bytes);
+        fp16_IO::pack(1.5f, bytes);
+        const std::int32_t values[3] = {1, -1, 8388607};
+        i24_IO::pack(values, 3, bytes);
+        assert(bytes.size() == 3 + 2 + 9);
+        assert(i24_IO::unpack<Endian::BIG>(bytes) == -2);
+        assert(fp16_IO::unpack(bytes, 3) == 1.5f);
+
+        std::pmr::vector<std::int32_t> unpacked(&resource);
+        i24_IO::unpack(bytes.data() + 5, 3, unpacked);
+        assert(unpacked.size() == 3 && unpacked[1] == -1 && unpacked[2] == 8388607);
+
+        // Other byte types
+        std::vector<char> chars;
+        u16_IO::pack<Endian::BIG>(0x4142, chars);
+        assert(chars[0] == 'A' && chars[1] == 'B' && u16_IO::unpack<Endian::BIG>(chars) == 0x4142);
+        std::vector<std::byte> raw;
+        const float floats[2] = {2.0f, -0.5f};
+        fp32_IO::pack(floats, 2, raw);
+        std::vector<float> unpacked_floats;
+        fp32_IO::unpack(reinterpret_cast<const std::uint8_t*>(raw.data()), 2, unpacked_floats);
+        assert(unpacked_floats[0] == 2.0f && fp32_IO::unpack(raw, 4) == -0.5f);
+        std::vector<std::int8_t> signed_bytes;
+        i8_IO::pack(-7, signed_bytes);
+        assert(signed_bytes[0] == -7 && i8_IO::unpack(signed_bytes) == -7);
+
+        // Gathering and scattering
+        std::pmr::vector<std::uint16_t> pmr_indices({2, 0}, &resource);
+        std::pmr::vector<std::int32_t> scattered_values({-3, 5}, &resource);
+        std::vector<char> scattered(3 * 3);
+        i24_IO::scatter_pack(scattered_values, pmr_indices, scattered);
+        std::pmr::vector<std::int32_t> gathered(&resource);
+        i24_IO::gather_unpack(scattered, pmr_indices, gathered);
+        assert((gathered == std::pmr::vector<std::int32_t>({-3, 5}, &resource)));
+        std::pmr::vector<float> pmr_floats({0.25f, -8.0f}, &resource);
+        std::vector<std::byte> scattered_floats(3 * 4);
+        fp32_IO::scatter_pack<Endian::BIG>(pmr_floats, pmr_indices, scattered_floats);
+        std::pmr::vector<float> gathered_floats(&resource);
+        fp32_IO::gather_unpack<Endian::BIG>(scattered_floats, std::vector<int>{2, 1, 0}, gathered_floats);
+        assert((gathered_floats == std::pmr::vector<float>({0.25f, 0.0f, -8.0f}, &resource)));
+    }
+
+    // Buffer pools
+    {
+        BufferPool pool(2);
+        {
+            BufferPool::Buffer a = pool.acquire(100);
+            assert(a.size() == 100 && a.capacity() == 128);
+            BufferPool::Buffer b = pool.acquire(64);
+            assert(b.capacity() == 64);
+            assert(pool.stats().bytes_in_use == 192 && pool.stats().n_hits == 0);
+        }
+        assert(pool.stats().bytes_in_use == 0 && pool.stats().bytes_cached == 192);
+
+        // Steady state recycles the same buffers
+        for (int i=0; i<10; i++) {
+            BufferPool::Buffer buffer = pool.acquire(120);
+            i24_IO::pack(-i, buffer.data());
+            assert(i24_IO::unpack(buffer.data()) == -i);
+        }
+        assert(pool.stats().n_acquired == 12 && pool.stats().n_hits == 10);
+        assert(pool.stats().hit_rate() > 0.8 && pool.stats().peak_bytes_in_use == 192);
+
+        // Oversized buffers aren't cached; per-class limits free the rest
+        {
+            BufferPool::Buffer huge = pool.acquire(BufferPool::MAX_CLASS_SIZE + 1);
+            assert(huge.capacity() == BufferPool::MAX_CLASS_SIZE + 1);
+            std::vector<BufferPool::Buffer> buffers;
+            for (int i=0; i<4; i++)
+                buffers.push_back(pool.acquire(1000));
+            BufferPool::Buffer moved = std::move(buffers[0]);
+            assert(buffers[0].data() == nullptr && moved.capacity() == 1024);
+        }
+        assert(pool.stats().bytes_cached == 192 + 2 * 1024);
+        pool.reset_stats();
+        assert(pool.stats().n_acquired == 0 && pool.stats().peak_bytes_in_use == 0);
+        pool.trim();
+        assert(pool.stats().bytes_cached == 0);
+
+        // Writers draw from the pool of their thread
+        const std::size_t n_hits = BufferPool::local().stats().n_hits;
+        std::vector<std::int32_t> values(100, 7);
+        for (int i=0; i<3; i++) {
+            std::stringstream stream;
+            NpyWriter::write<Endian::BIG>(stream, values);
+        }
+        assert(BufferPool::local().stats().n_hits == n_hits + 2);
+
+        // Batch stream writes don't allocate
+        std::stringstream stream;
+        i24_IO::write(values.data(), values.size(), stream);
+        std::vector<std::int32_t> read_values(values.size());
+        assert(i24_IO::read(stream, read_values.data(), read_values.size()) == values.size() && read_values == values);
+    }
+
+    // Conversions in constant expressions
+    {
+        constexpr std::array<std::uint8_t, 4> MAGIC = u32_IO::pack_array<Endian::BIG>(0x89504E47);
+        static_assert(MAGIC[0] == 0x89 && MAGIC[3] == 0x47);
+        static_assert(u32_IO::unpack<Endian::BIG>(MAGIC) == 0x89504E47);
+        static_assert(i24_IO::unpack(std::array<std::uint8_t, 3>{0xFE, 0xFF, 0xFF}) == -2);
+        static_assert(i24_IO::pack_array<Endian::BIG>(-8388608)[0] == 0x80);
+
+        static_assert(fp16_IO::encode(1.5f) == 0x3E00);
+        static_assert(fp16_IO::encode(65504.0f) == 0x7BFF);
+        static_assert(fp16_IO::encode(5.9604645e-8f) == 0x0001);
+        static_assert(fp16_IO::encode(std::numeric_limits<float>::infinity()) == 0x7C00);
+        static_assert(fp16_IO::encode(-std::numeric_limits<float>::infinity()) == 0xFC00);
+        static_assert(fp16_IO::encode(std::numeric_limits<float>::quiet_NaN()) == 0x7E00);
+        static_assert(fp16_IO::encode<OverflowPolicy::SATURATE>(1e6f) == 0x7BFF);
+        static_assert(fp16_IO::encode_rounded<RoundingMode::TOWARD_ZERO>(1.0009765f + 0.0004f) == 0x3C01);
+        static_assert(fp16_IO::decode(0x3C00) == 1.0f && fp16_IO::decode(0xC000) == -2.0f);
+        static_assert(fp16_IO::decode(0x0001) == 5.9604645e-8f);
+        static_assert(fp32_IO::decode(1) == std::numeric_limits<float>::denorm_min());
+        static_assert(fp64_IO::encode(0.1) == 0x3FB999999999999Aull);
+        static_assert(fp64_IO::encode(std::numeric_limits<double>::denorm_min()) == 1);
+        static_assert(fp64_IO::encode(std::numeric_limits<double>::max()) == 0x7FEFFFFFFFFFFFFFull);
+        static_assert(fp32_IO::unpack<Endian::BIG>(fp32_IO::pack_array<Endian::BIG>(-3.25f)) == -3.25f);
+        static_assert(i8_IO::unpack<Endian::BIG>(std::array<std::uint8_t, 1>{0xFF}) == -1);
+        static_assert(i8_IO::unpack<Endian::LITTLE>(std::array<std::uint8_t, 1>{0x80}) == -128);
+        static_assert(i16_IO::unpack<Endian::BIG>(std::array<std::uint8_t, 2>{0x80, 0x01}) == -32767);
+        static_assert(i32_IO::unpack<Endian::LITTLE>(i32_IO::pack_array<Endian::LITTLE>(-5)) == -5);
+        static_assert(i64_IO::unpack<Endian::BIG>(i64_IO::pack_array<Endian::BIG>(-1234567890123ll)) == -1234567890123ll);
+        #if defined(__GNUC__) && !defined(__clang__)
+            static_assert(fp16_IO::encode(-0.0f) == 0x8000);
+        #endif
+
+        // A lookup table for an 8-bit float format, built at compile time
+        using fp8_IO = FloatIO<float, std::uint8_t, 4, 3>;
+        constexpr auto TABLE = [] {
+            std::array<float, 256> table = {};
+            for (unsigned int i=0; i<256; i++)
+                table[i] = fp8_IO::decode(static_cast<std::uint8_t>(i));
+            return table;
+        }();
+        static_assert(TABLE[0x38] == 1.0f);
+        for (unsigned int i=0; i<256; i++) {
+            const float value = fp8_IO::decode(static_cast<std::uint8_t>(i));
+            assert(TABLE[i] == value || (TABLE[i] != TABLE[i] && value != value));
+            if (value == value)
+                assert(fp8_IO::encode(TABLE[i]) == i || (value == 0.0f && (i & 0x7F) == 0));
+        }
+
+        // Runtime and compile-time encoding agree
+        constexpr std::uint16_t THIRD = fp16_IO::encode(1.0f / 3.0f);
+        volatile float third = 1.0f / 3.0f;
+        assert(fp16_IO::encode(third) == THIRD);
+    }
+
+    // Table decoding
+    {
+        static_assert(fp16_table_IO::TABLE[0x3C00] == 1.0f && fp16_table_IO::decode(0xFBFF) == -65504.0f);
+        static_assert(bfloat16_table_IO::decode(0x3F80) == 1.0f);
+
+        // Every bit pattern decodes the same as with the arithmetic
+        for (std::uint32_t i=0; i<0x10000; i++) {
+            const float table = fp16_table_IO::decode(static_cast<std::uint16_t>(i));
+            const float arithmetic = fp16_IO::decode(static_cast<std::uint16_t>(i));
+            assert(table == arithmetic || (table != table && arithmetic != arithmetic));
+            assert(std::signbit(table) == std::signbit(arithmetic) || table != table);
+        }
+
+        // Denormal modes are part of the table
+        using fp16_daz_IO = FloatIO<float, std::uint16_t, 5, 10, false, DenormalMode::DAZ>;
+        static_assert(TableFloatIO<fp16_daz_IO>::decode(0x0001) == 0.0f);
+
+        const float values[] = {1.5f, -0.25f, 65504.0f, 0.0f, -std::numeric_limits<float>::infinity()};
+        std::uint8_t bytes[5 * 2];
+        fp16_table_IO::pack<Endian::BIG>(values, 5, bytes);
+        for (DecodeMethod method : {DecodeMethod::TABLE, DecodeMethod::ARITHMETIC}) {
+            float out[5] = {};
+            fp16_table_IO::unpack<Endian::BIG>(method, bytes, 5, out);
+            assert(std::memcmp(out, values, sizeof(values)) == 0);
+        }
+        float out[5] = {};
+        fp16_table_IO::unpack_fastest<Endian::BIG>(bytes, 5, out);
+        assert(std::memcmp(out, values, sizeof(values)) == 0);
+
+        const DecodeMethod method = fp16_table_IO::benchmark(1 << 12, 2);
+        assert(method == DecodeMethod::TABLE || method == DecodeMethod::ARITHMETIC);
+    }
+
+    // Byte layout of every width, for both endiannesses and with padding
+    {
+        constexpr auto BIG = u24_IO::pack_array<Endian::BIG>(0x123456);
+        constexpr auto LITTLE = u24_IO::pack_array<Endian::LITTLE>(0x123456);
+        static_assert(BIG[0] == 0x12 && BIG[1] == 0x34 && BIG[2] == 0x56);
+        static_assert(LITTLE[0] == 0x56 && LITTLE[1] == 0x34 && LITTLE[2] == 0x12);
+        using u24_aligned_IO = IntIO<std::uint32_t, 24, true>;
+        constexpr auto ALIGNED_BIG = u24_aligned_IO::pack_array<Endian::BIG>(0x123456);
+        constexpr auto ALIGNED_LITTLE = u24_aligned_IO::pack_array<Endian::LITTLE>(0x123456);
+        static_assert(ALIGNED_BIG[0] == 0 && ALIGNED_BIG[1] == 0x12 && ALIGNED_BIG[3] == 0x56);
+        static_assert(ALIGNED_LITTLE[0] == 0x56 && ALIGNED_LITTLE[2] == 0x12 && ALIGNED_LITTLE[3] == 0);
+        static_assert(u24_aligned_IO::unpack<Endian::BIG>(ALIGNED_BIG) == 0x123456);
+        static_assert(i24_IO::unpack<Endian::BIG>(std::array<std::uint8_t, 3>{0xFF, 0xFF, 0xFE}) == -2);
+
+        auto check = [](auto io, std::uint64_t value) {
+            using IO = decltype(io);
+            using T = typename IO::value_type;
+            std::uint8_t big[IO::N_IO_BYTES], little[IO::N_IO_BYTES];
+            IO::template pack<Endian::BIG>(static_cast<T>(value), big);
+            IO::template pack<Endian::LITTLE>(static_cast<T>(value), little);
+            for (int i=0; i<IO::N_IO_BYTES; i++)
+                assert(big[i] == little[IO::N_IO_BYTES - 1 - i]);
+            assert(little[0] == (value & 0xFF));
+            assert(IO::template unpack<Endian::BIG>(big) == static_cast<T>(value));
+            assert(IO::template unpack<Endian::LITTLE>(little) == static_cast<T>(value));
+        };
+        check(IntIO<std::uint64_t, 40, false>(), 0x0102030405ull);
+        check(IntIO<std::uint64_t, 48, false>(), 0x010203040506ull);
+        check(IntIO<std::uint64_t, 56, false>(), 0x01020304050607ull);
+        check(IntIO<std::uint64_t, 64, false>(), 0x0102030405060708ull);
+        check(IntIO<std::uint16_t, 12, false>(), 0x0ABC);
+        check(IntIO<std::uint8_t, 8, false>(), 0xA5);
+    }
+
     // std::cout << std::bitset<32>(value) << std::endl;
     // std::cout << value << std::endl;
 